@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+// Contention benchmarks of the process-wide ResolvedPathCache, from 1
+// to 128 threads, against a single mutex-guarded map as a baseline,
+// and with a budget too small for every entry, so inserts evict. The
+// InternedPathMemo, used for records kept for the whole process, is
+// run alongside for comparison.
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "pxr/usd/ar/resolvedPath.h"
+
+#include "internedPathMemo.h"
+#include "resolvedPathCache.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+constexpr std::size_t kEntryCount = 4096;
+// One in this many operations is an insert, in the mixed benchmarks.
+constexpr std::size_t kInsertInterval = 20;
+
+const std::vector<std::string> &assetPaths() {
+  static const std::vector<std::string> paths = [] {
+    std::vector<std::string> result;
+    result.reserve(kEntryCount);
+    for (std::size_t idx = 0; idx < kEntryCount; ++idx) {
+      result.push_back("bal:///asset/" + std::to_string(idx) + "/geo.usd");
+    }
+    return result;
+  }();
+  return paths;
+}
+
+// The simplest alternative, that sharding avoids.
+class MutexResolvedPathCache {
+ public:
+  bool find(const std::string_view assetPath, std::size_t /*contextHash*/,
+            ArResolvedPath &resolvedPath) const {
+    const std::lock_guard lock{mutex_};
+    const auto iter = entries_.find(std::string{assetPath});
+    if (iter == entries_.end()) {
+      return false;
+    }
+    resolvedPath = iter->second;
+    return true;
+  }
+
+  void insert(const std::string_view assetPath, std::size_t /*contextHash*/,
+              const ArResolvedPath &resolvedPath) {
+    const std::lock_guard lock{mutex_};
+    entries_[std::string{assetPath}] = resolvedPath;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::unordered_map<std::string, ArResolvedPath> entries_;
+};
+
+// Budgeted to hold roughly a third of the entries.
+class BoundedResolvedPathCache : public ResolvedPathCache {
+ public:
+  BoundedResolvedPathCache() : ResolvedPathCache{kEntryCount * 64} {}
+};
+
+template <class Cache>
+Cache &populatedCache() {
+  static Cache cache;
+  static std::once_flag populated;
+  std::call_once(populated, [] {
+    for (const std::string &assetPath : assetPaths()) {
+      cache.insert(assetPath, 0, ArResolvedPath{assetPath});
+    }
+  });
+  return cache;
+}
+
+template <class Cache>
+void find(benchmark::State &state) {
+  Cache &cache = populatedCache<Cache>();
+  const std::vector<std::string> &paths = assetPaths();
+  // Each thread walks the keys from a different starting point.
+  std::size_t idx = static_cast<std::size_t>(state.thread_index()) * 97;
+  ArResolvedPath resolvedPath;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(cache.find(paths[idx++ % kEntryCount], 0, resolvedPath));
+  }
+}
+
+template <class Cache>
+void findAndInsert(benchmark::State &state) {
+  Cache &cache = populatedCache<Cache>();
+  const std::vector<std::string> &paths = assetPaths();
+  std::size_t idx = static_cast<std::size_t>(state.thread_index()) * 97;
+  ArResolvedPath resolvedPath;
+  for ([[maybe_unused]] auto _ : state) {
+    const std::string &assetPath = paths[idx++ % kEntryCount];
+    if (idx % kInsertInterval == 0) {
+      cache.insert(assetPath, 0, ArResolvedPath{assetPath});
+    } else {
+      benchmark::DoNotOptimize(cache.find(assetPath, 0, resolvedPath));
+    }
+  }
+}
+}  // namespace
+
+// NOLINTBEGIN
+BENCHMARK_TEMPLATE(find, MutexResolvedPathCache)->ThreadRange(1, 128)->UseRealTime();
+BENCHMARK_TEMPLATE(find, ResolvedPathCache)->ThreadRange(1, 128)->UseRealTime();
+BENCHMARK_TEMPLATE(find, InternedPathMemo)->ThreadRange(1, 128)->UseRealTime();
+BENCHMARK_TEMPLATE(findAndInsert, MutexResolvedPathCache)->ThreadRange(1, 128)->UseRealTime();
+BENCHMARK_TEMPLATE(findAndInsert, ResolvedPathCache)->ThreadRange(1, 128)->UseRealTime();
+BENCHMARK_TEMPLATE(findAndInsert, BoundedResolvedPathCache)->ThreadRange(1, 128)->UseRealTime();
+BENCHMARK_TEMPLATE(findAndInsert, InternedPathMemo)->ThreadRange(1, 128)->UseRealTime();
+// NOLINTEND
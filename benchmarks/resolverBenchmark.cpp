@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+// Microbenchmarks of each UsdOpenAssetIOResolver override against its
+// ArDefaultResolver equivalent, so that the per-call overhead of the
+// wrapper is visible.
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+#include "pxr/usd/ar/defaultResolver.h"
+#include "pxr/usd/ar/resolvedPath.h"
+
+#include "resolver.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+const std::string kResourcesDir{OPENASSETIO_USDRESOLVER_TEST_RESOURCES};
+const std::string kSceneDir{kResourcesDir +
+                            "/integration_test_data/resolver_has_no_effect_with_no_search_path"};
+const std::string kLayerPath{kSceneDir + "/parking_lot.usd"};
+const std::string kRelativeLayerPath{"./floor1.usd"};
+const std::string kEntityReference{"bal:///floor"};
+
+template <class Resolver>
+void createIdentifier(benchmark::State &state) {
+  const Resolver resolver;
+  const ArResolvedPath anchor{kLayerPath};
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(resolver.CreateIdentifier(kRelativeLayerPath, anchor));
+  }
+}
+
+template <class Resolver>
+void createIdentifierForEntityReference(benchmark::State &state) {
+  const Resolver resolver;
+  const ArResolvedPath anchor{kLayerPath};
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(resolver.CreateIdentifier(kEntityReference, anchor));
+  }
+}
+
+template <class Resolver>
+void resolve(benchmark::State &state) {
+  const Resolver resolver;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(resolver.Resolve(kLayerPath));
+  }
+}
+
+template <class Resolver>
+void resolveEntityReference(benchmark::State &state) {
+  const Resolver resolver;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(resolver.Resolve(kEntityReference));
+  }
+}
+
+// Many threads resolving the same entity reference at once, as during
+// parallel composition.
+template <class Resolver>
+void resolveEntityReferenceConcurrently(benchmark::State &state) {
+  static const Resolver resolver;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(resolver.Resolve(kEntityReference));
+  }
+}
+
+template <class Resolver>
+void getExtension(benchmark::State &state) {
+  const Resolver resolver;
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(resolver.GetExtension(kLayerPath));
+  }
+}
+
+template <class Resolver>
+void getAssetInfo(benchmark::State &state) {
+  const Resolver resolver;
+  const ArResolvedPath resolvedPath{kLayerPath};
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(resolver.GetAssetInfo(kLayerPath, resolvedPath));
+  }
+}
+
+template <class Resolver>
+void getModificationTimestamp(benchmark::State &state) {
+  const Resolver resolver;
+  const ArResolvedPath resolvedPath{kLayerPath};
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(resolver.GetModificationTimestamp(kLayerPath, resolvedPath));
+  }
+}
+
+template <class Resolver>
+void openAsset(benchmark::State &state) {
+  const Resolver resolver;
+  const ArResolvedPath resolvedPath{kLayerPath};
+  for ([[maybe_unused]] auto _ : state) {
+    benchmark::DoNotOptimize(resolver.OpenAsset(resolvedPath));
+  }
+}
+}  // namespace
+
+// NOLINTBEGIN
+BENCHMARK_TEMPLATE(createIdentifier, ArDefaultResolver);
+BENCHMARK_TEMPLATE(createIdentifier, UsdOpenAssetIOResolver);
+BENCHMARK_TEMPLATE(createIdentifierForEntityReference, ArDefaultResolver);
+BENCHMARK_TEMPLATE(createIdentifierForEntityReference, UsdOpenAssetIOResolver);
+BENCHMARK_TEMPLATE(resolve, ArDefaultResolver);
+BENCHMARK_TEMPLATE(resolve, UsdOpenAssetIOResolver);
+BENCHMARK_TEMPLATE(resolveEntityReference, ArDefaultResolver);
+BENCHMARK_TEMPLATE(resolveEntityReference, UsdOpenAssetIOResolver);
+BENCHMARK_TEMPLATE(resolveEntityReferenceConcurrently, ArDefaultResolver)->ThreadRange(1, 64);
+BENCHMARK_TEMPLATE(resolveEntityReferenceConcurrently, UsdOpenAssetIOResolver)
+    ->ThreadRange(1, 64);
+BENCHMARK_TEMPLATE(getExtension, ArDefaultResolver);
+BENCHMARK_TEMPLATE(getExtension, UsdOpenAssetIOResolver);
+BENCHMARK_TEMPLATE(getAssetInfo, ArDefaultResolver);
+BENCHMARK_TEMPLATE(getAssetInfo, UsdOpenAssetIOResolver);
+BENCHMARK_TEMPLATE(getModificationTimestamp, ArDefaultResolver);
+BENCHMARK_TEMPLATE(getModificationTimestamp, UsdOpenAssetIOResolver);
+BENCHMARK_TEMPLATE(openAsset, ArDefaultResolver);
+BENCHMARK_TEMPLATE(openAsset, UsdOpenAssetIOResolver);
+// NOLINTEND
+
+BENCHMARK_MAIN();
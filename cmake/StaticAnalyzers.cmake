@@ -46,6 +46,8 @@ macro(enable_cpplint)
             --recursive
             ${PROJECT_SOURCE_DIR}/src
             ${PROJECT_SOURCE_DIR}/tests
+            ${PROJECT_SOURCE_DIR}/tools
+            ${PROJECT_SOURCE_DIR}/benchmarks
         )
 
     else ()
@@ -62,6 +64,8 @@ macro(enable_clang_format)
             CONFIGURE_DEPENDS # Ensure we re-scan if files change.
             ${PROJECT_SOURCE_DIR}/src/*.[ch]pp
             ${PROJECT_SOURCE_DIR}/src/*.[ch]
+            ${PROJECT_SOURCE_DIR}/tools/*.[ch]pp
+            ${PROJECT_SOURCE_DIR}/benchmarks/*.[ch]pp
         )
 
         # Create a custom target to be added as a dependency to other
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "assetBufferCache.h"
+
+#include <sys/stat.h>
+
+#include <iterator>
+
+namespace {
+// Rough size of the list and index nodes holding each entry.
+constexpr std::size_t kNodeBytes = 128;
+
+std::size_t chargeOf(const std::string &resolvedPath, const std::size_t bufferSize) {
+  // The path is held by both the entry and the index.
+  return bufferSize + resolvedPath.size() * 2 + kNodeBytes;
+}
+}  // namespace
+
+bool AssetBufferCache::FileStamp::of(const std::string &path, FileStamp &stamp) {
+  struct stat info {};
+  if (::stat(path.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+    return false;
+  }
+#ifdef __APPLE__
+  const struct timespec &modified = info.st_mtimespec;
+#else
+  const struct timespec &modified = info.st_mtim;
+#endif
+  stamp.modificationTimeNs =
+      static_cast<std::int64_t>(modified.tv_sec) * 1000000000 + modified.tv_nsec;
+  stamp.size = static_cast<std::uint64_t>(info.st_size);
+  stamp.inode = info.st_ino;
+  return true;
+}
+
+AssetBufferCache::AssetBufferCache(const std::size_t budgetBytes) : budgetBytes_{budgetBytes} {
+  stats_.budgetBytes = budgetBytes;
+}
+
+bool AssetBufferCache::find(const std::string &resolvedPath, const FileStamp &stamp,
+                            Buffer &buffer) {
+  const std::lock_guard lock{mutex_};
+  const auto iter = index_.find(resolvedPath);
+  if (iter == index_.end()) {
+    ++stats_.misses;
+    return false;
+  }
+  if (!(iter->second->stamp == stamp)) {
+    // The file has changed, so this version will not be opened again.
+    erase(iter->second);
+    ++stats_.misses;
+    return false;
+  }
+  entries_.splice(entries_.begin(), entries_, iter->second);
+  buffer = iter->second->buffer;
+  ++stats_.hits;
+  return true;
+}
+
+void AssetBufferCache::insert(const std::string &resolvedPath, const FileStamp &stamp,
+                              const Buffer &buffer) {
+  const std::size_t charge = chargeOf(resolvedPath, buffer.size);
+  const std::lock_guard lock{mutex_};
+  if (charge > budgetBytes_) {
+    ++stats_.rejections;
+    return;
+  }
+  if (const auto iter = index_.find(resolvedPath); iter != index_.end()) {
+    erase(iter->second);
+  }
+  while (bytes_ + charge > budgetBytes_) {
+    erase(std::prev(entries_.end()));
+    ++stats_.evictions;
+  }
+  entries_.push_front(Entry{resolvedPath, stamp, buffer});
+  index_.emplace(resolvedPath, entries_.begin());
+  bytes_ += charge;
+  ++stats_.insertions;
+}
+
+void AssetBufferCache::clear() {
+  const std::lock_guard lock{mutex_};
+  entries_.clear();
+  index_.clear();
+  bytes_ = 0;
+}
+
+CacheStats AssetBufferCache::stats() const {
+  const std::lock_guard lock{mutex_};
+  CacheStats result = stats_;
+  result.entries = entries_.size();
+  result.bytes = bytes_;
+  return result;
+}
+
+void AssetBufferCache::erase(const EntryList::iterator entry) {
+  bytes_ -= chargeOf(entry->resolvedPath, entry->buffer.size);
+  index_.erase(entry->resolvedPath);
+  entries_.erase(entry);
+}
@@ -0,0 +1,89 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "cacheStats.h"
+
+/**
+ * Process-wide cache of the contents of opened files, so that layers
+ * opened again, e.g. by another stage or a reload, are served from
+ * memory rather than read again.
+ *
+ * Entries are keyed by resolved path, and are only valid whilst the
+ * file's modification time, size and inode are unchanged, so are
+ * re-read after the file is rewritten or replaced. Buffers are shared
+ * and never modified, so every open of the same version of a file
+ * returns the same memory.
+ *
+ * The cache is bounded by a byte budget, evicting the least recently
+ * opened files first. Files larger than the budget are not cached.
+ * Unlike the resolved path caches, entries are few and large, so a
+ * single lock and an exact LRU suffice.
+ */
+class AssetBufferCache {
+ public:
+  /// Identifies a version of a file.
+  struct FileStamp {
+    std::int64_t modificationTimeNs{};
+    std::uint64_t size{};
+    std::uint64_t inode{};
+
+    bool operator==(const FileStamp &other) const {
+      return modificationTimeNs == other.modificationTimeNs && size == other.size &&
+             inode == other.inode;
+    }
+
+    /// The stamp of the file at a path, returning false if it is not
+    /// a regular file.
+    static bool of(const std::string &path, FileStamp &stamp);
+  };
+
+  struct Buffer {
+    std::shared_ptr<const char> data;
+    std::size_t size{};
+  };
+
+  explicit AssetBufferCache(std::size_t budgetBytes);
+
+  /// Whether a file of the given size could be cached, so whether it
+  /// is worth reading its contents for the cache.
+  [[nodiscard]] bool admits(const std::size_t size) const noexcept { return size < budgetBytes_; }
+
+  /// Look up the contents of a file, returning false if they are not
+  /// cached or were cached from a different version of the file.
+  bool find(const std::string &resolvedPath, const FileStamp &stamp, Buffer &buffer);
+
+  /// Add the contents of a file, replacing any from other versions.
+  void insert(const std::string &resolvedPath, const FileStamp &stamp, const Buffer &buffer);
+
+  /// Remove all entries.
+  void clear();
+
+  [[nodiscard]] CacheStats stats() const;
+
+ private:
+  struct Entry {
+    std::string resolvedPath;
+    FileStamp stamp;
+    Buffer buffer;
+  };
+  using EntryList = std::list<Entry>;
+
+  void erase(EntryList::iterator entry);
+
+  const std::size_t budgetBytes_;
+  mutable std::mutex mutex_;
+  // Most recently opened first.
+  EntryList entries_;
+  std::unordered_map<std::string, EntryList::iterator> index_;
+  std::size_t bytes_{0};
+  CacheStats stats_;
+};
@@ -0,0 +1,443 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "assetLocalizer.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <utility>
+
+#include "pxr/base/tf/diagnostic.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+using FileStamp = AssetBufferCache::FileStamp;
+
+constexpr std::size_t kChunkBytes = std::size_t{8} << 20U;
+// Age at which a temporary file left by another process is assumed to
+// be abandoned, e.g. by a crash. Copies in progress write far more
+// often than this.
+constexpr std::chrono::seconds kStaleCopyAge{60};
+constexpr std::string_view kPartialSuffix{".partial"};
+// Longer extensions are dropped from local file names.
+constexpr std::size_t kMaxExtensionSize = 16;
+
+std::uint64_t fnv1a(const std::string_view str) noexcept {
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const char chr : str) {
+    hash = (hash ^ static_cast<unsigned char>(chr)) * 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+// Hashes a word at a time, to keep up with local disk. Each step is a
+// bijection of the running hash, so any single changed word is always
+// detected.
+std::uint64_t contentHash(const char *data, const std::size_t size) noexcept {
+  constexpr std::uint64_t kMultiplier = 0x9e3779b97f4a7c15ULL;
+  std::uint64_t hash = size;
+  std::size_t pos = 0;
+  for (; pos + sizeof(std::uint64_t) <= size; pos += sizeof(std::uint64_t)) {
+    std::uint64_t word;
+    std::memcpy(&word, data + pos, sizeof(word));
+    hash = (hash ^ word) * kMultiplier;
+    hash ^= hash >> 32U;
+  }
+  for (; pos < size; ++pos) {
+    hash = (hash ^ static_cast<unsigned char>(data[pos])) * kMultiplier;
+  }
+  return hash;
+}
+
+bool isUnder(const std::string_view path, const std::string_view dir) noexcept {
+  return !dir.empty() && path.size() > dir.size() && path.compare(0, dir.size(), dir) == 0 &&
+         (dir.back() == '/' || path[dir.size()] == '/');
+}
+
+// A copy is current if it was made from the original as it is now.
+bool isCopyOf(const FileStamp &local, const FileStamp &original) noexcept {
+  return local.size == original.size && local.modificationTimeNs == original.modificationTimeNs;
+}
+
+bool readFully(const int fd, char *data, const std::size_t size, const std::uint64_t offset) {
+  std::size_t done = 0;
+  while (done < size) {
+    const ssize_t count =
+        ::pread(fd, data + done, size - done, static_cast<off_t>(offset + done));
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    // A short file was truncated whilst being copied.
+    if (count <= 0) {
+      return false;
+    }
+    done += static_cast<std::size_t>(count);
+  }
+  return true;
+}
+
+bool writeFully(const int fd, const char *data, const std::size_t size,
+                const std::uint64_t offset) {
+  std::size_t done = 0;
+  while (done < size) {
+    const ssize_t count =
+        ::pwrite(fd, data + done, size - done, static_cast<off_t>(offset + done));
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      return false;
+    }
+    done += static_cast<std::size_t>(count);
+  }
+  return true;
+}
+
+// Exclusively create the temporary file for a copy, returning -1 if
+// another process is already copying the same file.
+int createPartial(const std::string &partialPath) {
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    const int fd = ::open(partialPath.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0644);
+    if (fd >= 0 || errno != EEXIST) {
+      return fd;
+    }
+    struct stat info {};
+    if (::stat(partialPath.c_str(), &info) == 0) {
+      const auto age = std::chrono::system_clock::now() -
+                       std::chrono::system_clock::from_time_t(info.st_mtime);
+      if (age < kStaleCopyAge) {
+        return -1;
+      }
+      ::unlink(partialPath.c_str());
+    }
+  }
+  return -1;
+}
+}  // namespace
+
+struct AssetLocalizer::Copy {
+  std::string path;
+  std::string localPath;
+  std::string partialPath;
+  FileStamp stamp;
+  int sourceFd{-1};
+  int partialFd{-1};
+  std::atomic<std::size_t> remaining{0};
+  std::atomic<bool> failed{false};
+  bool committed{false};
+
+  ~Copy() {
+    if (sourceFd >= 0) {
+      ::close(sourceFd);
+    }
+    if (partialFd >= 0) {
+      ::close(partialFd);
+      if (!committed) {
+        ::unlink(partialPath.c_str());
+      }
+    }
+  }
+};
+
+std::unique_ptr<AssetLocalizer> AssetLocalizer::open(const std::string &cacheDir,
+                                                     std::vector<std::string> mountPoints,
+                                                     const std::size_t budgetBytes,
+                                                     const std::size_t threadCount) {
+  if (::mkdir(cacheDir.c_str(), 0755) != 0 && errno != EEXIST) {
+    TF_WARN("Failed to create asset localization directory '%s': %s", cacheDir.c_str(),
+            std::strerror(errno));
+    return nullptr;
+  }
+  // Private constructor, so make_unique is not available.
+  // NOLINTNEXTLINE(cppcoreguidelines-owning-memory)
+  return std::unique_ptr<AssetLocalizer>{
+      new AssetLocalizer{cacheDir, std::move(mountPoints), budgetBytes, threadCount}};
+}
+
+AssetLocalizer::AssetLocalizer(std::string cacheDir, std::vector<std::string> mountPoints,
+                               const std::size_t budgetBytes, const std::size_t threadCount)
+    : cacheDir_{std::move(cacheDir)},
+      mountPoints_{std::move(mountPoints)},
+      budgetBytes_{budgetBytes},
+      threadCount_{std::max<std::size_t>(threadCount, 1)} {
+  stats_.budgetBytes = budgetBytes_;
+}
+
+AssetLocalizer::~AssetLocalizer() {
+  {
+    const std::lock_guard lock{mutex_};
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &worker : workers_) {
+    worker.join();
+  }
+}
+
+bool AssetLocalizer::handles(const std::string_view path) const noexcept {
+  // Copies are never copied, even if the directory is on a slow mount.
+  return !isUnder(path, cacheDir_) &&
+         std::any_of(mountPoints_.begin(), mountPoints_.end(),
+                     [path](const std::string &mountPoint) { return isUnder(path, mountPoint); });
+}
+
+void AssetLocalizer::prefetch(const std::string &path) {
+  startOnce();
+  {
+    const std::lock_guard lock{mutex_};
+    // Copies since evicted, or made by other processes, are found
+    // when the file is opened.
+    if (index_.count(localPathOf(path)) != 0 || !copying_.insert(path).second) {
+      return;
+    }
+    tasks_.push_back(Task{path, nullptr, 0});
+  }
+  wake_.notify_one();
+}
+
+bool AssetLocalizer::find(const std::string &path, std::string &localPath) {
+  startOnce();
+  FileStamp original;
+  if (!FileStamp::of(path, original)) {
+    return false;
+  }
+  std::string candidate = localPathOf(path);
+  FileStamp local;
+  const bool current = FileStamp::of(candidate, local) && isCopyOf(local, original);
+  {
+    const std::lock_guard lock{mutex_};
+    if (current) {
+      use(candidate, local.size);
+      evictOverBudget();
+      ++stats_.hits;
+      localPath = std::move(candidate);
+      return true;
+    }
+    ++stats_.misses;
+    if (!copying_.insert(path).second) {
+      return false;
+    }
+    tasks_.push_back(Task{path, nullptr, 0});
+  }
+  wake_.notify_one();
+  return false;
+}
+
+CacheStats AssetLocalizer::stats() const {
+  const std::lock_guard lock{mutex_};
+  CacheStats result = stats_;
+  result.entries = entries_.size();
+  result.bytes = bytes_;
+  return result;
+}
+
+std::string AssetLocalizer::localPathOf(const std::string &path) const {
+  char name[17];
+  std::snprintf(name, sizeof(name), "%016" PRIx64, fnv1a(path));
+  std::string localPath = cacheDir_ + '/' + name;
+  // Keep the extension, so copies are recognisable.
+  if (const auto dot = path.rfind('.');
+      dot != std::string::npos && path.find('/', dot) == std::string::npos &&
+      path.size() - dot <= kMaxExtensionSize) {
+    localPath.append(path, dot, std::string::npos);
+  }
+  return localPath;
+}
+
+void AssetLocalizer::startOnce() {
+  std::call_once(started_, [this] {
+    // Account for copies left by earlier processes, oldest first, so
+    // they are the first evicted.
+    if (DIR *dir = ::opendir(cacheDir_.c_str())) {
+      struct Found {
+        std::time_t changeTime;
+        std::string localPath;
+        std::uint64_t size;
+      };
+      std::vector<Found> found;
+      while (const dirent *item = ::readdir(dir)) {
+        std::string localPath = cacheDir_ + '/' + item->d_name;
+        struct stat info {};
+        if (std::string_view{item->d_name}.find(kPartialSuffix) != std::string_view::npos ||
+            ::stat(localPath.c_str(), &info) != 0 || !S_ISREG(info.st_mode)) {
+          continue;
+        }
+        found.push_back(Found{info.st_ctime, std::move(localPath),
+                              static_cast<std::uint64_t>(info.st_size)});
+      }
+      ::closedir(dir);
+      std::sort(found.begin(), found.end(), [](const Found &lhs, const Found &rhs) {
+        return lhs.changeTime < rhs.changeTime;
+      });
+      const std::lock_guard lock{mutex_};
+      for (const Found &item : found) {
+        use(item.localPath, item.size);
+      }
+      evictOverBudget();
+    }
+    workers_.resize(threadCount_);
+    for (std::thread &worker : workers_) {
+      worker = std::thread{[this] { work(); }};
+    }
+  });
+}
+
+void AssetLocalizer::work() {
+  std::vector<char> buffer;
+  while (true) {
+    Task task;
+    {
+      std::unique_lock lock{mutex_};
+      wake_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      if (stopping_) {
+        return;
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    if (task.copy) {
+      copyChunk(*task.copy, task.chunk, buffer);
+    } else {
+      start(task.path);
+    }
+  }
+}
+
+void AssetLocalizer::start(const std::string &path) {
+  auto copy = std::make_shared<Copy>();
+  copy->path = path;
+  copy->localPath = localPathOf(path);
+  copy->partialPath = copy->localPath;
+  copy->partialPath.append(kPartialSuffix);
+  if (!FileStamp::of(path, copy->stamp) || copy->stamp.size == 0 ||
+      copy->stamp.size > budgetBytes_) {
+    finish(path);
+    return;
+  }
+  // Possibly copied by another process since.
+  if (FileStamp local; FileStamp::of(copy->localPath, local) && isCopyOf(local, copy->stamp)) {
+    const std::lock_guard lock{mutex_};
+    use(copy->localPath, local.size);
+    evictOverBudget();
+    copying_.erase(path);
+    return;
+  }
+  copy->partialFd = createPartial(copy->partialPath);
+  if (copy->partialFd >= 0) {
+    copy->sourceFd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  }
+  if (copy->sourceFd < 0 ||
+      ::ftruncate(copy->partialFd, static_cast<off_t>(copy->stamp.size)) != 0) {
+    finish(path);
+    return;
+  }
+  const std::size_t chunkCount = (copy->stamp.size + kChunkBytes - 1) / kChunkBytes;
+  copy->remaining = chunkCount;
+  {
+    const std::lock_guard lock{mutex_};
+    for (std::size_t chunk = 0; chunk < chunkCount; ++chunk) {
+      tasks_.push_back(Task{{}, copy, chunk});
+    }
+  }
+  wake_.notify_all();
+}
+
+void AssetLocalizer::copyChunk(Copy &copy, const std::size_t chunk, std::vector<char> &buffer) {
+  // Once any chunk has failed, the rest are skipped.
+  if (!copy.failed) {
+    const std::uint64_t offset = std::uint64_t{chunk} * kChunkBytes;
+    const std::size_t size = std::min(kChunkBytes, copy.stamp.size - offset);
+    buffer.resize(kChunkBytes);
+    bool copied = readFully(copy.sourceFd, buffer.data(), size, offset);
+    if (copied) {
+      // Read back what was written, to verify the local copy. Its
+      // pages must be clean before they can be dropped from the page
+      // cache, so that the read back is from disk.
+      const std::uint64_t hash = contentHash(buffer.data(), size);
+      copied = writeFully(copy.partialFd, buffer.data(), size, offset) &&
+               ::fdatasync(copy.partialFd) == 0;
+      if (copied) {
+        (void)::posix_fadvise(copy.partialFd, static_cast<off_t>(offset),
+                              static_cast<off_t>(size), POSIX_FADV_DONTNEED);
+        copied = readFully(copy.partialFd, buffer.data(), size, offset) &&
+                 contentHash(buffer.data(), size) == hash;
+      }
+    }
+    if (!copied) {
+      copy.failed = true;
+    }
+  }
+  if (copy.remaining.fetch_sub(1) == 1) {
+    commit(copy);
+  }
+}
+
+void AssetLocalizer::commit(Copy &copy) {
+  // The original must not have changed whilst being copied.
+  FileStamp current;
+  if (copy.failed || !FileStamp::of(copy.path, current) || !(current == copy.stamp)) {
+    finish(copy.path);
+    return;
+  }
+  // Copies are matched to their originals by modification time.
+  constexpr std::int64_t kNsPerSecond = 1000000000;
+  std::array<timespec, 2> times{};
+  times[0].tv_nsec = UTIME_NOW;
+  times[1].tv_sec = copy.stamp.modificationTimeNs / kNsPerSecond;
+  times[1].tv_nsec = copy.stamp.modificationTimeNs % kNsPerSecond;
+  if (::futimens(copy.partialFd, times.data()) != 0 ||
+      ::rename(copy.partialPath.c_str(), copy.localPath.c_str()) != 0) {
+    finish(copy.path);
+    return;
+  }
+  copy.committed = true;
+  const std::lock_guard lock{mutex_};
+  use(copy.localPath, copy.stamp.size);
+  ++stats_.insertions;
+  evictOverBudget();
+  copying_.erase(copy.path);
+}
+
+void AssetLocalizer::finish(const std::string &path) {
+  const std::lock_guard lock{mutex_};
+  copying_.erase(path);
+}
+
+void AssetLocalizer::use(const std::string &localPath, const std::uint64_t size) {
+  if (const auto iter = index_.find(localPath); iter != index_.end()) {
+    // Replaced, e.g. by another process, since last used.
+    bytes_ = bytes_ - iter->second->size + size;
+    iter->second->size = size;
+    entries_.splice(entries_.begin(), entries_, iter->second);
+    return;
+  }
+  entries_.push_front(Entry{localPath, size});
+  index_.emplace(localPath, entries_.begin());
+  bytes_ += size;
+}
+
+void AssetLocalizer::evictOverBudget() {
+  // The most recently used copy is kept, as it is about to be opened.
+  while (bytes_ > budgetBytes_ && entries_.size() > 1) {
+    const Entry &victim = entries_.back();
+    ::unlink(victim.localPath.c_str());
+    bytes_ -= victim.size;
+    index_.erase(victim.localPath);
+    entries_.pop_back();
+    ++stats_.evictions;
+  }
+}
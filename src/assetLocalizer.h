@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "assetBufferCache.h"
+#include "cacheStats.h"
+
+/**
+ * Read-through cache of files on slow mount points, e.g. NFS, in a
+ * directory on local disk, so that the processes on a host read each
+ * file from the network once rather than each time it is opened.
+ *
+ * Files are copied in the background, split into chunks copied in
+ * parallel by a pool of threads. Each chunk is hashed as it is read,
+ * written and flushed to disk, then evicted from the page cache, read
+ * back and hashed again, and the copy is only moved into place if
+ * every chunk matches and the file was not changed whilst being
+ * copied. Until then, the original is used. Eviction is only advice
+ * to the kernel, so where it is not taken the read back verifies
+ * the write, but not the disk.
+ *
+ * A copy is named by a hash of the original path, and is only used
+ * whilst its size and modification time match the original's, so a
+ * rewritten original is copied again. Copies are written to a
+ * temporary file and renamed into place, so processes sharing the
+ * directory never see partial copies, and a copy in progress in
+ * another process is not duplicated.
+ *
+ * The directory is bounded by a byte budget, deleting the least
+ * recently used copies first. Each process tracks the copies it has
+ * made or used, together with those found in the directory when it
+ * first looked up a file, so the budget is approximate when the
+ * directory is shared.
+ *
+ * The directory is not scanned, nor the threads started, until a
+ * file is first prefetched or looked up.
+ */
+class AssetLocalizer {
+ public:
+  /// Localize files under the given mount points to the given
+  /// directory, creating it if need be. Returns nullptr, with a
+  /// warning, if the directory cannot be created.
+  static std::unique_ptr<AssetLocalizer> open(const std::string &cacheDir,
+                                              std::vector<std::string> mountPoints,
+                                              std::size_t budgetBytes, std::size_t threadCount);
+
+  /// Stop copying, abandoning copies in progress.
+  ~AssetLocalizer();
+
+  AssetLocalizer(const AssetLocalizer &) = delete;
+  AssetLocalizer &operator=(const AssetLocalizer &) = delete;
+
+  /// Whether a path is under one of the slow mount points.
+  [[nodiscard]] bool handles(std::string_view path) const noexcept;
+
+  /// Start copying a file in the background, unless being copied, or
+  /// already copied, by this process. Does not touch the filesystem.
+  void prefetch(const std::string &path);
+
+  /// Look up the local copy of a file, starting a copy if there is no
+  /// up to date copy, returning false until it is complete.
+  bool find(const std::string &path, std::string &localPath);
+
+  [[nodiscard]] CacheStats stats() const;
+
+ private:
+  // A file being copied, shared by the tasks copying its chunks.
+  struct Copy;
+  // Either the start of a copy, or a chunk of one.
+  struct Task {
+    std::string path;
+    std::shared_ptr<Copy> copy;
+    std::size_t chunk{};
+  };
+  struct Entry {
+    std::string localPath;
+    std::uint64_t size;
+  };
+  using EntryList = std::list<Entry>;
+
+  AssetLocalizer(std::string cacheDir, std::vector<std::string> mountPoints,
+                 std::size_t budgetBytes, std::size_t threadCount);
+
+  [[nodiscard]] std::string localPathOf(const std::string &path) const;
+  // Account for the copies already in the directory, and start the
+  // threads, the first time it is called.
+  void startOnce();
+  void work();
+  void start(const std::string &path);
+  void copyChunk(Copy &copy, std::size_t chunk, std::vector<char> &buffer);
+  void commit(Copy &copy);
+  void finish(const std::string &path);
+  // Must be called with the mutex held.
+  void use(const std::string &localPath, std::uint64_t size);
+  void evictOverBudget();
+
+  const std::string cacheDir_;
+  const std::vector<std::string> mountPoints_;
+  const std::size_t budgetBytes_;
+  const std::size_t threadCount_;
+
+  std::once_flag started_;
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::deque<Task> tasks_;
+  bool stopping_{false};
+  // Paths being copied.
+  std::unordered_set<std::string> copying_;
+  // Most recently used first.
+  EntryList entries_;
+  std::unordered_map<std::string, EntryList::iterator> index_;
+  std::uint64_t bytes_{0};
+  CacheStats stats_;
+
+  std::vector<std::thread> workers_;
+};
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstddef>
+
+#include <pxr/usd/ar/assetInfo.h>
+#include <pxr/usd/ar/resolvedPath.h>
+#include <pxr/usd/ar/timestamp.h>
+
+#include "budgetedCache.h"
+
+/**
+ * Asset info cached for an asset path, valid only whilst the asset
+ * path still resolves to the same resolved path.
+ */
+struct CachedAssetInfo {
+  PXR_NS::ArResolvedPath resolvedPath;
+  PXR_NS::ArAssetInfo info;
+};
+
+/**
+ * Modification timestamp cached for an asset path, valid only whilst
+ * the asset path still resolves to the same resolved path.
+ */
+struct CachedTimestamp {
+  PXR_NS::ArResolvedPath resolvedPath;
+  PXR_NS::ArTimestamp timestamp;
+};
+
+template <>
+struct BudgetedCacheTraits<CachedAssetInfo> {
+  static std::size_t heapBytes(const CachedAssetInfo &cached) noexcept {
+    return cached.resolvedPath.GetPathString().capacity() + cached.info.version.capacity() +
+           cached.info.assetName.capacity() + cached.info.repoPath.capacity();
+  }
+};
+
+template <>
+struct BudgetedCacheTraits<CachedTimestamp> {
+  static std::size_t heapBytes(const CachedTimestamp &cached) noexcept {
+    return cached.resolvedPath.GetPathString().capacity();
+  }
+};
+
+using AssetInfoCache = BudgetedCache<CachedAssetInfo>;
+using TimestampCache = BudgetedCache<CachedTimestamp>;
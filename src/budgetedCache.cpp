@@ -0,0 +1,14 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "budgetedCache.h"
+
+// ------------------------------------------------------------
+/* ResolveKey */
+std::size_t ResolveKey::hash(const std::string_view assetPath,
+                             const std::size_t contextHash) noexcept {
+  // boost::hash_combine.
+  std::size_t seed = std::hash<std::string_view>{}(assetPath);
+  seed ^= contextHash + 0x9e3779b9U + (seed << 6U) + (seed >> 2U);
+  return seed;
+}
@@ -0,0 +1,452 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "cacheStats.h"
+#include "frequencySketch.h"
+
+/**
+ * Identifies a resolution: an asset path, and a hash of the resolver
+ * context it was resolved in.
+ */
+struct ResolveKey {
+  std::string assetPath;
+  std::size_t contextHash{};
+
+  bool operator==(const ResolveKey &other) const {
+    return contextHash == other.contextHash && assetPath == other.assetPath;
+  }
+
+  static std::size_t hash(std::string_view assetPath, std::size_t contextHash) noexcept;
+
+  struct Hash {
+    std::size_t operator()(const ResolveKey &key) const noexcept {
+      return ResolveKey::hash(key.assetPath, key.contextHash);
+    }
+  };
+};
+
+/**
+ * Estimated heap memory owned by a cached value, charged to the
+ * cache's budget along with the entry itself. Specialise for values
+ * that own heap memory.
+ */
+template <class Value>
+struct BudgetedCacheTraits {
+  static std::size_t heapBytes(const Value & /*value*/) noexcept { return 0; }
+};
+
+/**
+ * Process-wide cache of values keyed by asset path and a hash of the
+ * resolver context, shared by all threads, and optionally bounded by
+ * a byte budget.
+ *
+ * Entries are spread across shards by hash, each guarded by its own
+ * reader-writer lock, so lookups only ever share a shard's lock and
+ * inserts only contend with other accesses to the same shard. Lookups
+ * copy the value out, so allocate only as copying a Value does, e.g.
+ * for an ArResolvedPath's string.
+ *
+ * When bounded, each shard evicts by W-TinyLFU. New entries enter a
+ * small LRU window, and each, on leaving it for a full main segment,
+ * must have been used more often, per a frequency sketch, than the
+ * probation entries it would displace. So one-off accesses, e.g. a sweep over every asset of
+ * a show, cannot flush out frequently used entries, as they would
+ * from an LRU. The main segment is a segmented LRU, of probation and
+ * protected entries.
+ *
+ * Since lookups only share the lock, they cannot reorder entries.
+ * Instead, recency is approximated CLOCK-style: a lookup marks the
+ * entry, and a marked entry reaching the tail of a segment is moved
+ * to the head (or promoted, from probation) rather than evicted.
+ */
+template <class Value>
+class BudgetedCache {
+ public:
+  /// A budget of 0 bytes leaves the cache unbounded.
+  explicit BudgetedCache(std::size_t budgetBytes = 0);
+
+  /// Look up a value, returning false if it is not cached.
+  bool find(std::string_view assetPath, std::size_t contextHash, Value &value) const;
+
+  /// Add a value, replacing any existing entry for the key.
+  void insert(std::string_view assetPath, std::size_t contextHash, const Value &value);
+
+  /// Add a value unless the key already has one, returning the value
+  /// now cached for the key.
+  Value insertIfAbsent(std::string_view assetPath, std::size_t contextHash, const Value &value);
+
+  /// Call the given function with every entry, in no particular order.
+  /// Each shard is locked whilst its entries are visited.
+  void forEach(
+      const std::function<void(std::string_view, std::size_t, const Value &)> &func) const;
+
+  /// Remove all entries.
+  void clear();
+
+  [[nodiscard]] CacheStats stats() const;
+
+ private:
+  static constexpr std::size_t kShardCount = 64;
+  // Proportions of each shard's budget given to the window, and of
+  // the main segment to protected entries, as in Caffeine.
+  static constexpr std::size_t kWindowPercent = 1;
+  static constexpr std::size_t kProtectedPercent = 80;
+  // Rough size of the list and index nodes holding each entry.
+  static constexpr std::size_t kNodeBytes = 64;
+  // Assumed typical entry size, for sizing the frequency sketches.
+  static constexpr std::size_t kTypicalEntryBytes = 256;
+
+  enum class Segment : std::uint8_t { kWindow, kProbation, kProtected };
+
+  struct Entry {
+    Entry(std::string_view path, std::size_t context, std::size_t keyHash,
+          const Value &cachedValue)
+        : assetPath{path}, contextHash{context}, hash{keyHash}, value{cachedValue} {}
+
+    std::string assetPath;
+    std::size_t contextHash;
+    std::size_t hash;
+    Value value;
+    std::size_t charge{};
+    Segment segment{Segment::kWindow};
+    // Set by lookups, cleared when the entry is given a second chance.
+    mutable std::atomic<bool> referenced{false};
+  };
+  using EntryList = std::list<Entry>;
+  using EntryIter = typename EntryList::iterator;
+
+  // Keyed by the full hash, so lookups need not construct a key.
+  // Entries with colliding hashes are told apart by comparing keys.
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_multimap<std::size_t, EntryIter> index;
+    std::array<EntryList, 3> segments;
+    std::array<std::size_t, 3> segmentBytes{};
+    // Null if unbounded.
+    std::unique_ptr<FrequencySketch> sketch;
+    mutable std::atomic<std::uint64_t> hits{0};
+    mutable std::atomic<std::uint64_t> misses{0};
+    std::uint64_t insertions{0};
+    std::uint64_t evictions{0};
+    std::uint64_t rejections{0};
+  };
+
+  static std::size_t shardIndex(std::size_t hash) noexcept;
+
+  // The entry for a key, or nullptr if there is none.
+  static const EntryIter *findEntry(const Shard &shard, std::size_t hash,
+                                    std::string_view assetPath, std::size_t contextHash);
+
+  static std::size_t chargeOf(const Entry &entry) noexcept;
+
+  static void add(Shard &shard, std::size_t hash, std::string_view assetPath,
+                  std::size_t contextHash, const Value &value);
+
+  static void replace(Shard &shard, EntryIter entry, const Value &value);
+
+  // Move an entry to the head of a segment.
+  static void move(Shard &shard, EntryIter entry, Segment segment);
+
+  static void erase(Shard &shard, EntryIter entry);
+
+  // Evict until the shard is within budget.
+  void evict(Shard &shard) const;
+
+  // The least recently used unmarked probation entry, promoting those
+  // marked on the way, or the end of probation if it is empty.
+  EntryIter probationVictim(Shard &shard) const;
+
+  const std::size_t budgetBytes_;
+  const std::size_t windowBytes_;
+  const std::size_t mainBytes_;
+  const std::size_t protectedBytes_;
+  std::array<Shard, kShardCount> shards_;
+};
+
+// ------------------------------------------------------------
+/* Implementation */
+template <class Value>
+BudgetedCache<Value>::BudgetedCache(const std::size_t budgetBytes)
+    : budgetBytes_{budgetBytes},
+      windowBytes_{budgetBytes / kShardCount * kWindowPercent / 100},
+      mainBytes_{budgetBytes / kShardCount - windowBytes_},
+      protectedBytes_{mainBytes_ * kProtectedPercent / 100} {
+  if (budgetBytes_ == 0) {
+    return;
+  }
+  for (Shard &shard : shards_) {
+    shard.sketch =
+        std::make_unique<FrequencySketch>(budgetBytes_ / kShardCount / kTypicalEntryBytes);
+  }
+}
+
+template <class Value>
+bool BudgetedCache<Value>::find(const std::string_view assetPath, const std::size_t contextHash,
+                                Value &value) const {
+  const std::size_t hash = ResolveKey::hash(assetPath, contextHash);
+  const Shard &shard = shards_[shardIndex(hash)];
+  // Misses are counted too, so that a key's frequency is known when
+  // it is first inserted.
+  if (shard.sketch) {
+    shard.sketch->increment(hash);
+  }
+
+  const std::shared_lock lock{shard.mutex};
+  const EntryIter *entry = findEntry(shard, hash, assetPath, contextHash);
+  if (!entry) {
+    shard.misses.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  // Avoid writing to the entry's cache line if already marked.
+  if (!(*entry)->referenced.load(std::memory_order_relaxed)) {
+    (*entry)->referenced.store(true, std::memory_order_relaxed);
+  }
+  value = (*entry)->value;
+  shard.hits.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
+template <class Value>
+void BudgetedCache<Value>::insert(const std::string_view assetPath,
+                                  const std::size_t contextHash, const Value &value) {
+  const std::size_t hash = ResolveKey::hash(assetPath, contextHash);
+  Shard &shard = shards_[shardIndex(hash)];
+
+  const std::unique_lock lock{shard.mutex};
+  if (const EntryIter *entry = findEntry(shard, hash, assetPath, contextHash)) {
+    replace(shard, *entry, value);
+  } else {
+    add(shard, hash, assetPath, contextHash, value);
+  }
+  if (shard.sketch) {
+    evict(shard);
+  }
+}
+
+template <class Value>
+Value BudgetedCache<Value>::insertIfAbsent(const std::string_view assetPath,
+                                           const std::size_t contextHash, const Value &value) {
+  const std::size_t hash = ResolveKey::hash(assetPath, contextHash);
+  Shard &shard = shards_[shardIndex(hash)];
+
+  const std::unique_lock lock{shard.mutex};
+  if (const EntryIter *entry = findEntry(shard, hash, assetPath, contextHash)) {
+    return (*entry)->value;
+  }
+  add(shard, hash, assetPath, contextHash, value);
+  if (shard.sketch) {
+    evict(shard);
+  }
+  return value;
+}
+
+template <class Value>
+void BudgetedCache<Value>::forEach(
+    const std::function<void(std::string_view, std::size_t, const Value &)> &func) const {
+  for (const Shard &shard : shards_) {
+    const std::shared_lock lock{shard.mutex};
+    for (const EntryList &segment : shard.segments) {
+      for (const Entry &entry : segment) {
+        func(entry.assetPath, entry.contextHash, entry.value);
+      }
+    }
+  }
+}
+
+template <class Value>
+void BudgetedCache<Value>::clear() {
+  for (Shard &shard : shards_) {
+    const std::unique_lock lock{shard.mutex};
+    shard.index.clear();
+    for (EntryList &segment : shard.segments) {
+      segment.clear();
+    }
+    shard.segmentBytes = {};
+  }
+}
+
+template <class Value>
+CacheStats BudgetedCache<Value>::stats() const {
+  CacheStats result;
+  result.budgetBytes = budgetBytes_;
+  for (const Shard &shard : shards_) {
+    const std::shared_lock lock{shard.mutex};
+    result.hits += shard.hits.load(std::memory_order_relaxed);
+    result.misses += shard.misses.load(std::memory_order_relaxed);
+    result.insertions += shard.insertions;
+    result.evictions += shard.evictions;
+    result.rejections += shard.rejections;
+    result.entries += shard.index.size();
+    for (const std::size_t bytes : shard.segmentBytes) {
+      result.bytes += bytes;
+    }
+  }
+  return result;
+}
+
+template <class Value>
+std::size_t BudgetedCache<Value>::shardIndex(const std::size_t hash) noexcept {
+  // Use different bits to those that pick the bucket within a shard.
+  return (hash >> 16U) % kShardCount;
+}
+
+template <class Value>
+const typename BudgetedCache<Value>::EntryIter *BudgetedCache<Value>::findEntry(
+    const Shard &shard, const std::size_t hash, const std::string_view assetPath,
+    const std::size_t contextHash) {
+  const auto [begin, end] = shard.index.equal_range(hash);
+  for (auto iter = begin; iter != end; ++iter) {
+    const EntryIter &entry = iter->second;
+    if (entry->contextHash == contextHash && entry->assetPath == assetPath) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+template <class Value>
+std::size_t BudgetedCache<Value>::chargeOf(const Entry &entry) noexcept {
+  return sizeof(Entry) + kNodeBytes + entry.assetPath.capacity() +
+         BudgetedCacheTraits<Value>::heapBytes(entry.value);
+}
+
+template <class Value>
+void BudgetedCache<Value>::add(Shard &shard, const std::size_t hash,
+                               const std::string_view assetPath, const std::size_t contextHash,
+                               const Value &value) {
+  EntryList &window = shard.segments[static_cast<std::size_t>(Segment::kWindow)];
+  window.emplace_front(assetPath, contextHash, hash, value);
+  const EntryIter entry = window.begin();
+  entry->charge = chargeOf(*entry);
+  shard.segmentBytes[static_cast<std::size_t>(Segment::kWindow)] += entry->charge;
+  shard.index.emplace(hash, entry);
+  ++shard.insertions;
+}
+
+template <class Value>
+void BudgetedCache<Value>::replace(Shard &shard, const EntryIter entry, const Value &value) {
+  std::size_t &segmentBytes = shard.segmentBytes[static_cast<std::size_t>(entry->segment)];
+  segmentBytes -= entry->charge;
+  entry->value = value;
+  entry->charge = chargeOf(*entry);
+  segmentBytes += entry->charge;
+}
+
+template <class Value>
+void BudgetedCache<Value>::move(Shard &shard, const EntryIter entry, const Segment segment) {
+  const auto from = static_cast<std::size_t>(entry->segment);
+  const auto to = static_cast<std::size_t>(segment);
+  shard.segments[to].splice(shard.segments[to].begin(), shard.segments[from], entry);
+  shard.segmentBytes[from] -= entry->charge;
+  shard.segmentBytes[to] += entry->charge;
+  entry->segment = segment;
+}
+
+template <class Value>
+void BudgetedCache<Value>::erase(Shard &shard, const EntryIter entry) {
+  const auto [begin, end] = shard.index.equal_range(entry->hash);
+  for (auto iter = begin; iter != end; ++iter) {
+    if (iter->second == entry) {
+      shard.index.erase(iter);
+      break;
+    }
+  }
+  shard.segmentBytes[static_cast<std::size_t>(entry->segment)] -= entry->charge;
+  shard.segments[static_cast<std::size_t>(entry->segment)].erase(entry);
+}
+
+template <class Value>
+void BudgetedCache<Value>::evict(Shard &shard) const {
+  constexpr auto kWindow = static_cast<std::size_t>(Segment::kWindow);
+  constexpr auto kProbation = static_cast<std::size_t>(Segment::kProbation);
+  constexpr auto kProtected = static_cast<std::size_t>(Segment::kProtected);
+  EntryList &window = shard.segments[kWindow];
+  EntryList &probation = shard.segments[kProbation];
+  const auto mainBytes = [&shard] {
+    return shard.segmentBytes[kProbation] + shard.segmentBytes[kProtected];
+  };
+
+  // Each entry leaving the window is a candidate for the main segment,
+  // admitted only whilst used more often than the victim at the tail of
+  // probation. Ties favour the victim, as in TinyLFU. Every loop below
+  // either clears a mark or moves or erases an entry, so terminates.
+  while (shard.segmentBytes[kWindow] > windowBytes_ && !window.empty()) {
+    const EntryIter candidate = std::prev(window.end());
+    if (candidate->referenced.exchange(false, std::memory_order_relaxed)) {
+      move(shard, candidate, Segment::kWindow);
+      continue;
+    }
+    bool admitted = true;
+    while (mainBytes() + candidate->charge > mainBytes_) {
+      const EntryIter victim = probationVictim(shard);
+      if (victim == probation.end()) {
+        break;
+      }
+      if (shard.sketch->frequency(candidate->hash) <= shard.sketch->frequency(victim->hash)) {
+        admitted = false;
+        break;
+      }
+      erase(shard, victim);
+      ++shard.evictions;
+    }
+    if (admitted) {
+      move(shard, candidate, Segment::kProbation);
+    } else {
+      erase(shard, candidate);
+      ++shard.rejections;
+      ++shard.evictions;
+    }
+  }
+
+  // Entries may also outgrow the main segment in place, e.g. when their
+  // value is replaced, or when there was no victim to displace.
+  while (mainBytes() > mainBytes_) {
+    const EntryIter victim = probationVictim(shard);
+    if (victim == probation.end()) {
+      break;
+    }
+    erase(shard, victim);
+    ++shard.evictions;
+  }
+}
+
+template <class Value>
+typename BudgetedCache<Value>::EntryIter BudgetedCache<Value>::probationVictim(
+    Shard &shard) const {
+  constexpr auto kProtected = static_cast<std::size_t>(Segment::kProtected);
+  EntryList &probation = shard.segments[static_cast<std::size_t>(Segment::kProbation)];
+  EntryList &protectedEntries = shard.segments[kProtected];
+
+  while (!probation.empty()) {
+    const EntryIter victim = std::prev(probation.end());
+    if (!victim->referenced.exchange(false, std::memory_order_relaxed)) {
+      return victim;
+    }
+    move(shard, victim, Segment::kProtected);
+    // Demote the least recently used protected entries to make room.
+    while (shard.segmentBytes[kProtected] > protectedBytes_) {
+      const EntryIter demoted = std::prev(protectedEntries.end());
+      if (demoted->referenced.exchange(false, std::memory_order_relaxed)) {
+        move(shard, demoted, Segment::kProtected);
+      } else {
+        move(shard, demoted, Segment::kProbation);
+      }
+    }
+  }
+  return probation.end();
+}
@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "cacheStats.h"
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+#include <utility>
+
+// ------------------------------------------------------------
+/* CacheStats */
+CacheStats &CacheStats::operator+=(const CacheStats &other) {
+  hits += other.hits;
+  misses += other.misses;
+  insertions += other.insertions;
+  evictions += other.evictions;
+  rejections += other.rejections;
+  entries += other.entries;
+  bytes += other.bytes;
+  budgetBytes += other.budgetBytes;
+  return *this;
+}
+
+// ------------------------------------------------------------
+/* CacheStatsRegistry */
+CacheStatsRegistry &CacheStatsRegistry::instance() {
+  // Deliberately leaked, see header.
+  static auto *const instance = new CacheStatsRegistry;  // NOLINT(cppcoreguidelines-owning-memory)
+  return *instance;
+}
+
+std::uint64_t CacheStatsRegistry::add(std::string name, Source source) {
+  const std::lock_guard lock{mutex_};
+  const std::uint64_t id = nextId_++;
+  registrations_.push_back({id, std::move(name), std::move(source)});
+  return id;
+}
+
+void CacheStatsRegistry::remove(const std::uint64_t id) {
+  const std::lock_guard lock{mutex_};
+  registrations_.erase(
+      std::remove_if(registrations_.begin(), registrations_.end(),
+                     [id](const Registration &registration) { return registration.id == id; }),
+      registrations_.end());
+}
+
+std::string CacheStatsRegistry::toJson() const {
+  std::map<std::string, CacheStats> stats;
+  {
+    const std::lock_guard lock{mutex_};
+    for (const Registration &registration : registrations_) {
+      stats[registration.name] += registration.source();
+    }
+  }
+  std::ostringstream json;
+  json << "{";
+  const char *separator = "";
+  for (const auto &[name, cache] : stats) {
+    json << separator << "\"" << name << "\": {\"hits\": " << cache.hits
+         << ", \"misses\": " << cache.misses << ", \"insertions\": " << cache.insertions
+         << ", \"evictions\": " << cache.evictions << ", \"rejections\": " << cache.rejections
+         << ", \"entries\": " << cache.entries << ", \"bytes\": " << cache.bytes
+         << ", \"budget_bytes\": " << cache.budgetBytes << "}";
+    separator = ", ";
+  }
+  json << "}";
+  return json.str();
+}
+
+// ------------------------------------------------------------
+/* C API */
+const char *UsdOpenAssetIOResolverCacheStatsJson() {
+  thread_local std::string json;
+  json = CacheStatsRegistry::instance().toJson();
+  return json.c_str();
+}
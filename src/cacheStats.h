@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Counters of a cache's effectiveness and size.
+ */
+struct CacheStats {
+  std::uint64_t hits{};
+  std::uint64_t misses{};
+  std::uint64_t insertions{};
+  std::uint64_t evictions{};
+  // New entries evicted in favour of more frequently used ones.
+  std::uint64_t rejections{};
+  std::uint64_t entries{};
+  std::uint64_t bytes{};
+  // Zero if unbounded.
+  std::uint64_t budgetBytes{};
+
+  CacheStats &operator+=(const CacheStats &other);
+};
+
+/**
+ * Process-wide registry of the caches of all resolvers, so their
+ * stats can be read without a handle on any resolver.
+ */
+class CacheStatsRegistry {
+ public:
+  using Source = std::function<CacheStats()>;
+
+  /// The process-wide instance. Never destroyed, so is safe to use
+  /// from other static destructors and exit handlers.
+  static CacheStatsRegistry &instance();
+
+  /// Register a cache, returning an id for removing it. Caches with
+  /// the same name, e.g. of different resolvers, are reported summed.
+  std::uint64_t add(std::string name, Source source);
+
+  void remove(std::uint64_t id);
+
+  /// Serialise to JSON, keyed by cache name.
+  [[nodiscard]] std::string toJson() const;
+
+ private:
+  struct Registration {
+    std::uint64_t id;
+    std::string name;
+    Source source;
+  };
+
+  CacheStatsRegistry() = default;
+
+  mutable std::mutex mutex_;
+  std::uint64_t nextId_{1};
+  std::vector<Registration> registrations_;
+};
+
+/**
+ * C entry point for reading cache stats from Python via ctypes. See
+ * CallStats.
+ */
+extern "C" {
+/// JSON snapshot of the cache stats. Valid until the next call on
+/// the same thread.
+const char *UsdOpenAssetIOResolverCacheStatsJson();
+}
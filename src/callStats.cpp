@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "callStats.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <utility>
+
+// ------------------------------------------------------------
+/* LatencyBuckets */
+std::size_t LatencyBuckets::index(const std::uint64_t ns) noexcept {
+  if (ns < kSubBucketCount) {
+    return ns;
+  }
+  // Position of the most significant bit, at least kSubBucketBits.
+  unsigned exponent = 63U - static_cast<unsigned>(__builtin_clzll(ns));
+  if (exponent > kMaxExponent) {
+    return kBucketCount - 1;
+  }
+  const std::uint64_t subBucket = (ns >> (exponent - kSubBucketBits)) & (kSubBucketCount - 1);
+  return (exponent - kSubBucketBits + 1) * kSubBucketCount + subBucket;
+}
+
+std::uint64_t LatencyBuckets::lowerBound(const std::size_t index) noexcept {
+  if (index < kSubBucketCount) {
+    return index;
+  }
+  const std::uint64_t exponent = index / kSubBucketCount + kSubBucketBits - 1;
+  const std::uint64_t subBucket = index % kSubBucketCount;
+  return (kSubBucketCount + subBucket) << (exponent - kSubBucketBits);
+}
+
+// ------------------------------------------------------------
+/* CallStatsSnapshot */
+std::uint64_t CallStatsSnapshot::Method::quantileNs(const double quantile) const {
+  if (count == 0) {
+    return 0;
+  }
+  const auto rank = static_cast<std::uint64_t>(quantile * static_cast<double>(count - 1));
+  std::uint64_t cumulative = 0;
+  for (std::size_t idx = 0; idx < buckets.size(); ++idx) {
+    cumulative += buckets[idx];
+    if (cumulative > rank) {
+      // Report the top of the bucket, but never more than was seen.
+      const std::uint64_t upperBound = idx + 1 < buckets.size()
+                                           ? LatencyBuckets::lowerBound(idx + 1) - 1
+                                           : LatencyBuckets::lowerBound(idx);
+      return std::min(upperBound, maxNs);
+    }
+  }
+  return maxNs;
+}
+
+std::string CallStatsSnapshot::toJson() const {
+  std::ostringstream json;
+  json << "{";
+  const char *separator = "";
+  for (std::size_t methodIdx = 0; methodIdx < methods.size(); ++methodIdx) {
+    const Method &method = methods[methodIdx];
+    if (method.count == 0) {
+      continue;
+    }
+    json << separator << "\"" << resolverMethodName(static_cast<ResolverMethod>(methodIdx))
+         << "\": {\"count\": " << method.count << ", \"total_ns\": " << method.totalNs
+         << ", \"max_ns\": " << method.maxNs << ", \"p50_ns\": " << method.quantileNs(0.5)
+         << ", \"p90_ns\": " << method.quantileNs(0.9)
+         << ", \"p99_ns\": " << method.quantileNs(0.99)
+         << ", \"p999_ns\": " << method.quantileNs(0.999) << ", \"buckets\": [";
+    // Sparse [lower bound ns, count] pairs.
+    const char *bucketSeparator = "";
+    for (std::size_t idx = 0; idx < method.buckets.size(); ++idx) {
+      if (method.buckets[idx] != 0) {
+        json << bucketSeparator << "[" << LatencyBuckets::lowerBound(idx) << ", "
+             << method.buckets[idx] << "]";
+        bucketSeparator = ", ";
+      }
+    }
+    json << "]}";
+    separator = ", ";
+  }
+  json << "}";
+  return json.str();
+}
+
+// ------------------------------------------------------------
+/* CallStats */
+CallStats &CallStats::instance() {
+  // Deliberately leaked, see header.
+  static auto *const instance = new CallStats;  // NOLINT(cppcoreguidelines-owning-memory)
+  return *instance;
+}
+
+CallStats::ThreadBlockLease::ThreadBlockLease(CallStats &callStats) : owner{callStats} {
+  const std::lock_guard lock{owner.mutex_};
+  block = owner.threadBlocks_.emplace_back(std::make_unique<ThreadBlock>()).get();
+}
+
+CallStats::ThreadBlockLease::~ThreadBlockLease() { owner.retire(block); }
+
+CallStats::ThreadBlock &CallStats::threadBlock() {
+  thread_local const ThreadBlockLease lease{*this};
+  return *lease.block;
+}
+
+void CallStats::retire(const ThreadBlock *block) {
+  const std::lock_guard lock{mutex_};
+  merge(*block, retired_);
+  threadBlocks_.erase(std::find_if(
+      threadBlocks_.begin(), threadBlocks_.end(),
+      [block](const std::unique_ptr<ThreadBlock> &other) { return other.get() == block; }));
+}
+
+void CallStats::merge(const ThreadBlock &block, CallStatsSnapshot &snapshot) {
+  for (std::size_t methodIdx = 0; methodIdx < kResolverMethodCount; ++methodIdx) {
+    const ThreadBlock::Method &stats = block.methods[methodIdx];
+    CallStatsSnapshot::Method &merged = snapshot.methods[methodIdx];
+    merged.count += stats.count.load(std::memory_order_relaxed);
+    merged.totalNs += stats.totalNs.load(std::memory_order_relaxed);
+    merged.maxNs = std::max(merged.maxNs, stats.maxNs.load(std::memory_order_relaxed));
+    for (std::size_t idx = 0; idx < LatencyBuckets::kBucketCount; ++idx) {
+      merged.buckets[idx] += stats.buckets[idx].load(std::memory_order_relaxed);
+    }
+  }
+}
+
+void CallStats::record(const ResolverMethod method, const CallClock::duration duration) noexcept {
+  const auto ns = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+  ThreadBlock::Method &stats = threadBlock().methods[static_cast<std::size_t>(method)];
+
+  // Only this thread writes to its block, so plain load/store pairs
+  // suffice; readers merely need untorn values.
+  stats.count.store(stats.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  stats.totalNs.store(stats.totalNs.load(std::memory_order_relaxed) + ns,
+                      std::memory_order_relaxed);
+  if (ns > stats.maxNs.load(std::memory_order_relaxed)) {
+    stats.maxNs.store(ns, std::memory_order_relaxed);
+  }
+  auto &bucket = stats.buckets[LatencyBuckets::index(ns)];
+  bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+CallStatsSnapshot CallStats::snapshot() const {
+  const std::lock_guard lock{mutex_};
+  CallStatsSnapshot snapshot = retired_;
+  for (const auto &block : threadBlocks_) {
+    merge(*block, snapshot);
+  }
+  return snapshot;
+}
+
+void CallStats::reset() {
+  // Racy with respect to in-flight calls, which may be partially
+  // counted. Acceptable for instrumentation.
+  const std::lock_guard lock{mutex_};
+  retired_ = CallStatsSnapshot{};
+  for (const auto &block : threadBlocks_) {
+    for (ThreadBlock::Method &stats : block->methods) {
+      stats.count.store(0, std::memory_order_relaxed);
+      stats.totalNs.store(0, std::memory_order_relaxed);
+      stats.maxNs.store(0, std::memory_order_relaxed);
+      for (auto &bucket : stats.buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+      }
+    }
+  }
+}
+
+void CallStats::dumpAtExit(std::string path) {
+  const std::lock_guard lock{mutex_};
+  if (dumpPath_.empty()) {
+    std::atexit(&CallStats::dump);
+  }
+  dumpPath_ = std::move(path);
+}
+
+void CallStats::dump() {
+  CallStats &stats = instance();
+  const std::string json = stats.snapshot().toJson();
+  const bool toStderr = stats.dumpPath_ == "-";
+  std::FILE *file = toStderr ? stderr : std::fopen(stats.dumpPath_.c_str(), "w");
+  if (!file) {
+    std::fprintf(stderr, "Failed to write resolver call stats to '%s'\n",
+                 stats.dumpPath_.c_str());
+    return;
+  }
+  std::fprintf(file, "%s\n", json.c_str());
+  if (!toStderr) {
+    std::fclose(file);
+  }
+}
+
+// ------------------------------------------------------------
+/* C API */
+const char *UsdOpenAssetIOResolverCallStatsJson() {
+  thread_local std::string json;
+  json = CallStats::instance().snapshot().toJson();
+  return json.c_str();
+}
+
+void UsdOpenAssetIOResolverResetCallStats() { CallStats::instance().reset(); }
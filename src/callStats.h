@@ -0,0 +1,139 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "resolverMethod.h"
+
+/**
+ * Log-linear bucketing of call latencies, in the style of an HDR
+ * histogram.
+ *
+ * Each power of two range of nanoseconds is split into
+ * `kSubBucketCount` linear sub-buckets, bounding the relative error of
+ * any reported latency to 1/kSubBucketCount. Latencies beyond
+ * 2^kMaxExponent ns (~18 minutes) are clamped into the last bucket.
+ */
+struct LatencyBuckets {
+  static constexpr unsigned kSubBucketBits = 3;
+  static constexpr std::uint64_t kSubBucketCount = 1U << kSubBucketBits;
+  static constexpr unsigned kMaxExponent = 40;
+  static constexpr std::size_t kBucketCount =
+      (kMaxExponent - kSubBucketBits + 2) * kSubBucketCount;
+
+  static std::size_t index(std::uint64_t ns) noexcept;
+  static std::uint64_t lowerBound(std::size_t index) noexcept;
+};
+
+/**
+ * Merged call counts and latencies for each resolver method.
+ */
+struct CallStatsSnapshot {
+  struct Method {
+    std::uint64_t count{};
+    std::uint64_t totalNs{};
+    std::uint64_t maxNs{};
+    std::array<std::uint64_t, LatencyBuckets::kBucketCount> buckets{};
+
+    /// Approximate latency at the given quantile, in [0, 1].
+    [[nodiscard]] std::uint64_t quantileNs(double quantile) const;
+  };
+  std::array<Method, kResolverMethodCount> methods{};
+
+  /// Serialise to JSON, keyed by method name, omitting uncalled
+  /// methods.
+  [[nodiscard]] std::string toJson() const;
+};
+
+/**
+ * Process-wide, always-available resolver call counters and latency
+ * histograms.
+ *
+ * Each thread accumulates into its own block of relaxed atomics, so
+ * recording never contends with other threads. Blocks are merged when
+ * a snapshot is taken. When a thread exits, its block is folded into
+ * a total of retired blocks and freed, so no calls are lost, and hosts
+ * that repeatedly create threads do not accumulate blocks.
+ */
+class CallStats {
+ public:
+  /// The process-wide instance. Never destroyed, so is safe to use
+  /// from other static destructors and exit handlers.
+  static CallStats &instance();
+
+  void record(ResolverMethod method, CallClock::duration duration) noexcept;
+
+  [[nodiscard]] CallStatsSnapshot snapshot() const;
+
+  void reset();
+
+  /// Write a JSON snapshot to the given file ("-" for stderr) when
+  /// the process exits.
+  void dumpAtExit(std::string path);
+
+ private:
+  struct ThreadBlock {
+    struct Method {
+      std::atomic<std::uint64_t> count{};
+      std::atomic<std::uint64_t> totalNs{};
+      std::atomic<std::uint64_t> maxNs{};
+      std::array<std::atomic<std::uint64_t>, LatencyBuckets::kBucketCount> buckets{};
+    };
+    std::array<Method, kResolverMethodCount> methods{};
+  };
+
+  // Registers a block for the calling thread, retiring it when the
+  // thread exits.
+  struct ThreadBlockLease {
+    explicit ThreadBlockLease(CallStats &callStats);
+    ~ThreadBlockLease();
+
+    ThreadBlockLease(const ThreadBlockLease &) = delete;
+    ThreadBlockLease &operator=(const ThreadBlockLease &) = delete;
+
+    CallStats &owner;
+    ThreadBlock *block;
+  };
+
+  CallStats() = default;
+
+  ThreadBlock &threadBlock();
+
+  // Fold the counts of an exiting thread's block into retired_, and
+  // free it.
+  void retire(const ThreadBlock *block);
+
+  static void merge(const ThreadBlock &block, CallStatsSnapshot &snapshot);
+
+  static void dump();
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<ThreadBlock>> threadBlocks_;
+  // Counts of the blocks of threads that have exited.
+  CallStatsSnapshot retired_;
+  std::string dumpPath_;
+};
+
+/**
+ * C entry points for reading stats from Python via ctypes, e.g.
+ *
+ *   lib = ctypes.CDLL(Plug.Registry().GetPluginWithName(
+ *       "usdOpenAssetIOResolver").path)
+ *   lib.UsdOpenAssetIOResolverCallStatsJson.restype = ctypes.c_char_p
+ *   stats = json.loads(lib.UsdOpenAssetIOResolverCallStatsJson())
+ */
+extern "C" {
+/// JSON snapshot of the call stats. Valid until the next call on the
+/// same thread.
+const char *UsdOpenAssetIOResolverCallStatsJson();
+
+void UsdOpenAssetIOResolverResetCallStats();
+}
@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "callTrace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+
+#include "pxr/base/tf/diagnostic.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+constexpr std::string_view kMagic{"OAIOTRC1"};
+
+// Buffered output, so each record is a single (locked) fwrite.
+constexpr std::size_t kFileBufferSize = 1U << 20U;
+
+std::uint32_t currentThreadIndex() {
+  static std::atomic<std::uint32_t> nextThreadIndex{0};
+  thread_local const std::uint32_t threadIndex = nextThreadIndex++;
+  return threadIndex;
+}
+
+void appendVarint(std::string &out, std::uint64_t value) {
+  while (value >= 0x80U) {
+    out.push_back(static_cast<char>((value & 0x7FU) | 0x80U));
+    value >>= 7U;
+  }
+  out.push_back(static_cast<char>(value));
+}
+
+void appendString(std::string &out, std::string_view str) {
+  appendVarint(out, str.size());
+  out.append(str);
+}
+
+bool readVarint(std::FILE *file, std::uint64_t &value) {
+  value = 0;
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    const int byte = std::fgetc(file);
+    if (byte == EOF) {
+      return false;
+    }
+    value |= (static_cast<std::uint64_t>(byte) & 0x7FU) << shift;
+    if ((static_cast<unsigned>(byte) & 0x80U) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool readString(std::FILE *file, std::string &str) {
+  std::uint64_t size = 0;
+  if (!readVarint(file, size)) {
+    return false;
+  }
+  str.resize(size);
+  return size == 0 || std::fread(str.data(), 1, str.size(), file) == str.size();
+}
+
+std::uint64_t nanoseconds(const CallClock::duration duration) {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count());
+}
+}  // namespace
+
+// Directories may contain the platform's search path separator, but
+// not newlines.
+std::string encodeSearchPath(const std::vector<std::string> &searchPath) {
+  std::string encoded;
+  for (const std::string &dir : searchPath) {
+    if (!encoded.empty()) {
+      encoded.push_back('\n');
+    }
+    encoded.append(dir);
+  }
+  return encoded;
+}
+
+std::vector<std::string> decodeSearchPath(std::string_view encoded) {
+  std::vector<std::string> searchPath;
+  while (!encoded.empty()) {
+    const std::size_t end = std::min(encoded.find('\n'), encoded.size());
+    searchPath.emplace_back(encoded.substr(0, end));
+    encoded.remove_prefix(std::min(end + 1, encoded.size()));
+  }
+  return searchPath;
+}
+
+// ------------------------------------------------------------
+/* CallTraceWriter */
+std::unique_ptr<CallTraceWriter> CallTraceWriter::open(const std::string &path) {
+  std::FILE *file = std::fopen(path.c_str(), "wb");
+  if (!file) {
+    TF_WARN("Failed to open resolver call trace '%s' for writing: %s", path.c_str(),
+            std::strerror(errno));
+    return nullptr;
+  }
+  std::setvbuf(file, nullptr, _IOFBF, kFileBufferSize);
+  std::fwrite(kMagic.data(), 1, kMagic.size(), file);
+  // Private constructor, so make_unique is not available.
+  return std::unique_ptr<CallTraceWriter>(new CallTraceWriter(file, path));  // NOLINT
+}
+
+CallTraceWriter::CallTraceWriter(std::FILE *file, std::string path)
+    : file_{file}, path_{std::move(path)}, origin_{CallClock::now()} {}
+
+CallTraceWriter::~CallTraceWriter() {
+  if (std::fclose(file_) != 0) {
+    TF_WARN("Failed to write resolver call trace '%s'", path_.c_str());
+  }
+}
+
+void CallTraceWriter::write(const ResolverMethod method, const CallClock::time_point start,
+                            const CallClock::time_point end, const std::string_view arg0,
+                            const std::string_view arg1, const std::string_view result) const {
+  // Encode outside of the lock, reusing a per-thread buffer.
+  thread_local std::string record;
+  record.clear();
+  record.push_back(static_cast<char>(method));
+  appendVarint(record, currentThreadIndex());
+  appendVarint(record, nanoseconds(start - origin_));
+  appendVarint(record, nanoseconds(end - start));
+  appendString(record, arg0);
+  appendString(record, arg1);
+  appendString(record, result);
+
+  const std::lock_guard lock{mutex_};
+  std::fwrite(record.data(), 1, record.size(), file_);
+}
+
+// ------------------------------------------------------------
+/* CallTraceReader */
+std::unique_ptr<CallTraceReader> CallTraceReader::open(const std::string &path) {
+  std::FILE *file = std::fopen(path.c_str(), "rb");
+  if (!file) {
+    TF_WARN("Failed to open resolver call trace '%s' for reading: %s", path.c_str(),
+            std::strerror(errno));
+    return nullptr;
+  }
+  // Private constructor, so make_unique is not available.
+  std::unique_ptr<CallTraceReader> reader{new CallTraceReader(file)};  // NOLINT
+
+  char magic[kMagic.size()];
+  if (std::fread(magic, 1, sizeof(magic), file) != sizeof(magic) ||
+      std::string_view{magic, sizeof(magic)} != kMagic) {
+    TF_WARN("'%s' is not a resolver call trace", path.c_str());
+    return nullptr;
+  }
+  return reader;
+}
+
+CallTraceReader::CallTraceReader(std::FILE *file) : file_{file} {}
+
+CallTraceReader::~CallTraceReader() { std::fclose(file_); }
+
+bool CallTraceReader::next(CallTraceRecord &record) {
+  const int method = std::fgetc(file_);
+  if (method == EOF || static_cast<std::size_t>(method) >= kResolverMethodCount) {
+    return false;
+  }
+  record.method = static_cast<ResolverMethod>(method);
+
+  std::uint64_t threadIndex = 0;
+  if (!readVarint(file_, threadIndex) || !readVarint(file_, record.startNs) ||
+      !readVarint(file_, record.durationNs) || !readString(file_, record.arg0) ||
+      !readString(file_, record.arg1) || !readString(file_, record.result)) {
+    return false;
+  }
+  record.threadIndex = static_cast<std::uint32_t>(threadIndex);
+  return true;
+}
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "resolverMethod.h"
+
+/**
+ * A single recorded resolver call.
+ *
+ * Arguments and results are recorded as strings. Unused arguments are
+ * left empty. Context binds record the search path of the bound
+ * ArDefaultResolverContext, if any, as arg0, encoded by
+ * encodeSearchPath, so that replays resolve in the same context.
+ */
+struct CallTraceRecord {
+  ResolverMethod method{};
+  // Small sequential index of the calling thread, in order of each
+  // thread's first recorded call.
+  std::uint32_t threadIndex{};
+  // Nanoseconds since the trace was opened.
+  std::uint64_t startNs{};
+  std::uint64_t durationNs{};
+  std::string arg0;
+  std::string arg1;
+  std::string result;
+};
+
+/// Encode a search path as a single trace argument.
+std::string encodeSearchPath(const std::vector<std::string> &searchPath);
+
+/// Decode a search path encoded by encodeSearchPath.
+std::vector<std::string> decodeSearchPath(std::string_view encoded);
+
+/**
+ * Records resolver calls to a compact binary trace file.
+ *
+ * The file is a magic header followed by a sequence of records. Each
+ * record is the method byte followed by LEB128 varints for the thread
+ * index, start time and duration, then the two arguments and the
+ * result as varint length-prefixed strings.
+ *
+ * Safe to call from multiple threads. Records are written in the order
+ * calls complete.
+ */
+class CallTraceWriter {
+ public:
+  /// Open a trace file for writing, truncating any existing file.
+  /// Returns nullptr, with a warning, if the file cannot be opened.
+  static std::unique_ptr<CallTraceWriter> open(const std::string &path);
+
+  ~CallTraceWriter();
+
+  CallTraceWriter(const CallTraceWriter &) = delete;
+  CallTraceWriter &operator=(const CallTraceWriter &) = delete;
+
+  void write(ResolverMethod method, CallClock::time_point start, CallClock::time_point end,
+             std::string_view arg0, std::string_view arg1, std::string_view result) const;
+
+ private:
+  CallTraceWriter(std::FILE *file, std::string path);
+
+  std::FILE *file_;
+  const std::string path_;
+  const CallClock::time_point origin_;
+  mutable std::mutex mutex_;
+};
+
+/**
+ * Reads records back from a trace file written by CallTraceWriter.
+ */
+class CallTraceReader {
+ public:
+  /// Open a trace file for reading. Returns nullptr, with a warning,
+  /// if the file cannot be opened or is not a call trace.
+  static std::unique_ptr<CallTraceReader> open(const std::string &path);
+
+  ~CallTraceReader();
+
+  CallTraceReader(const CallTraceReader &) = delete;
+  CallTraceReader &operator=(const CallTraceReader &) = delete;
+
+  /// Read the next record, returning false at the end of the file or
+  /// if the file is truncated.
+  bool next(CallTraceRecord &record);
+
+ private:
+  explicit CallTraceReader(std::FILE *file);
+
+  std::FILE *file_;
+};
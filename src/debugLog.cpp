@@ -0,0 +1,246 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "debugLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdlib>
+#include <cstring>
+
+#include "pxr/base/tf/envSetting.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+PXR_NAMESPACE_OPEN_SCOPE
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_LOG_ASYNC, false,
+                      "Write OPENASSETIO_RESOLVER debug output from a background "
+                      "thread, rather than synchronously through TfDebug.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_LOG_SAMPLE, 1,
+                      "Emit only one in every N OPENASSETIO_RESOLVER debug records, "
+                      "per thread.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_LOG_RATE_LIMIT, 0,
+                      "Maximum OPENASSETIO_RESOLVER debug records emitted per second, "
+                      "across all threads. Unlimited if 0.")
+
+PXR_NAMESPACE_CLOSE_SCOPE
+
+namespace {
+constexpr std::string_view kTruncated{"...\n"};
+
+// How long the writer thread sleeps when the ring is empty.
+constexpr std::chrono::milliseconds kWriterInterval{5};
+
+std::uint64_t positiveSetting(const int value) {
+  return value > 0 ? static_cast<std::uint64_t>(value) : 0;
+}
+
+// The characters written to a buffer by snprintf, which returns the
+// untruncated length.
+template <std::size_t N>
+std::string_view printed(const std::array<char, N> &buffer, const int size) {
+  return {buffer.data(), std::min(static_cast<std::size_t>(std::max(size, 0)), N - 1)};
+}
+
+char *threadBuffer() noexcept {
+  thread_local std::array<char, DebugLog::kMaxRecordSize> buffer;
+  return buffer.data();
+}
+}  // namespace
+
+// ------------------------------------------------------------
+/* DebugLog */
+DebugLog &DebugLog::instance() {
+  // Deliberately leaked, see header.
+  static auto *const instance = new DebugLog;  // NOLINT(cppcoreguidelines-owning-memory)
+  return *instance;
+}
+
+DebugLog::DebugLog()
+    : sampleInterval_{std::max<std::uint64_t>(
+          1, positiveSetting(TfGetEnvSetting(OPENASSETIO_RESOLVER_LOG_SAMPLE)))},
+      rateLimit_{positiveSetting(TfGetEnvSetting(OPENASSETIO_RESOLVER_LOG_RATE_LIMIT))} {
+  if (!TfGetEnvSetting(OPENASSETIO_RESOLVER_LOG_ASYNC)) {
+    return;
+  }
+  slots_ = std::make_unique<Slot[]>(kSlotCount);  // NOLINT(*-avoid-c-arrays)
+  for (std::size_t idx = 0; idx < kSlotCount; ++idx) {
+    slots_[idx].sequence.store(idx, std::memory_order_relaxed);
+  }
+  writing_.store(true, std::memory_order_release);
+  writer_ = std::thread{&DebugLog::runWriter, this};
+  std::atexit(&DebugLog::stopWriter);
+}
+
+bool DebugLog::shouldLog() noexcept {
+  if (!TfDebug::IsEnabled(OPENASSETIO_RESOLVER)) {
+    return false;
+  }
+  if (sampleInterval_ > 1) {
+    thread_local std::uint64_t sampleCount = 0;
+    if (sampleCount++ % sampleInterval_ != 0) {
+      return false;
+    }
+  }
+  if (rateLimit_ > 0) {
+    const auto second = static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+    // Fixed one second windows. The reset races with concurrent
+    // increments, which may let a few extra records through.
+    if (std::uint64_t window = rateWindow_.load(std::memory_order_relaxed);
+        window != second &&
+        rateWindow_.compare_exchange_strong(window, second, std::memory_order_relaxed)) {
+      rateWindowCount_.store(0, std::memory_order_relaxed);
+    }
+    if (rateWindowCount_.fetch_add(1, std::memory_order_relaxed) >= rateLimit_) {
+      rateLimited_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+  }
+  return true;
+}
+
+void DebugLog::write(const std::string_view record) noexcept {
+  if (writing_.load(std::memory_order_acquire)) {
+    if (!tryPush(record)) {
+      dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return;
+  }
+  TfDebug::Helper::Msg("%.*s", static_cast<int>(record.size()), record.data());
+}
+
+bool DebugLog::tryPush(const std::string_view record) noexcept {
+  // Bounded multi-producer queue, after Vyukov. Each slot's sequence
+  // number says whether it is free for the producer at a position, or
+  // filled for the consumer.
+  std::size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+  Slot *slot = nullptr;
+  for (;;) {
+    slot = &slots_[pos % kSlotCount];
+    const std::size_t sequence = slot->sequence.load(std::memory_order_acquire);
+    if (sequence == pos) {
+      if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+        break;
+      }
+    } else if (sequence < pos) {
+      // Full, since the consumer has not yet released this slot.
+      return false;
+    } else {
+      pos = enqueuePos_.load(std::memory_order_relaxed);
+    }
+  }
+  const std::size_t size = std::min(record.size(), slot->data.size());
+  std::memcpy(slot->data.data(), record.data(), size);
+  slot->size = static_cast<std::uint32_t>(size);
+  slot->sequence.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+void DebugLog::drain(std::FILE *file) {
+  bool wrote = false;
+  for (;;) {
+    Slot &slot = slots_[dequeuePos_ % kSlotCount];
+    if (slot.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+      break;
+    }
+    std::fwrite(slot.data.data(), 1, slot.size, file);
+    slot.sequence.store(dequeuePos_ + kSlotCount, std::memory_order_release);
+    ++dequeuePos_;
+    wrote = true;
+  }
+  if (const std::uint64_t dropped = dropped_.exchange(0, std::memory_order_relaxed)) {
+    std::fprintf(file, "OPENASSETIO_RESOLVER: dropped %" PRIu64 " records\n", dropped);
+    wrote = true;
+  }
+  if (const std::uint64_t limited = rateLimited_.exchange(0, std::memory_order_relaxed)) {
+    std::fprintf(file, "OPENASSETIO_RESOLVER: rate limited %" PRIu64 " records\n", limited);
+    wrote = true;
+  }
+  if (wrote) {
+    std::fflush(file);
+  }
+}
+
+void DebugLog::runWriter() {
+  std::unique_lock lock{writerMutex_};
+  while (!stopping_) {
+    lock.unlock();
+    drain(stdout);
+    lock.lock();
+    writerWakeup_.wait_for(lock, kWriterInterval, [this] { return stopping_; });
+  }
+  lock.unlock();
+  drain(stdout);
+}
+
+void DebugLog::stopWriter() {
+  DebugLog &log = instance();
+  {
+    const std::lock_guard lock{log.writerMutex_};
+    log.stopping_ = true;
+  }
+  log.writerWakeup_.notify_one();
+  log.writer_.join();
+  // Records emitted after this point, e.g. from static destructors,
+  // are written synchronously. Records pushed whilst switching over
+  // are flushed here, bar any that race with this final drain.
+  log.writing_.store(false, std::memory_order_release);
+  log.drain(stdout);
+}
+
+// ------------------------------------------------------------
+/* DebugLogRecord */
+DebugLogRecord::DebugLogRecord(const std::string_view function) noexcept
+    : buffer_{threadBuffer()} {
+  append("OPENASSETIO_RESOLVER: ");
+  append(function);
+  append("\n");
+}
+
+DebugLogRecord::~DebugLogRecord() { DebugLog::instance().write({buffer_, size_}); }
+
+DebugLogRecord &DebugLogRecord::field(const std::string_view name,
+                                      const std::string_view value) noexcept {
+  append("  ");
+  append(name);
+  append(": ");
+  append(value);
+  append("\n");
+  return *this;
+}
+
+DebugLogRecord &DebugLogRecord::field(const std::string_view name,
+                                      const std::int64_t value) noexcept {
+  std::array<char, 24> digits{};
+  return field(name, printed(digits, std::snprintf(digits.data(), digits.size(), "%" PRId64,
+                                                   value)));
+}
+
+DebugLogRecord &DebugLogRecord::field(const std::string_view name, const double value) noexcept {
+  // Matches std::to_string, as previously used for these fields.
+  std::array<char, 64> digits{};
+  return field(name, printed(digits, std::snprintf(digits.data(), digits.size(), "%f", value)));
+}
+
+void DebugLogRecord::append(const std::string_view str) noexcept {
+  // Leave room to mark truncated records.
+  constexpr std::size_t kCapacity = DebugLog::kMaxRecordSize - kTruncated.size();
+  if (size_ > kCapacity) {
+    return;
+  }
+  if (str.size() > kCapacity - size_) {
+    std::memcpy(buffer_ + size_, str.data(), kCapacity - size_);
+    std::memcpy(buffer_ + kCapacity, kTruncated.data(), kTruncated.size());
+    size_ = DebugLog::kMaxRecordSize;
+    return;
+  }
+  std::memcpy(buffer_ + size_, str.data(), str.size());
+  size_ += str.size();
+}
@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+
+#include <pxr/base/tf/debug.h>
+
+PXR_NAMESPACE_OPEN_SCOPE
+TF_DEBUG_CODES(OPENASSETIO_RESOLVER)
+PXR_NAMESPACE_CLOSE_SCOPE
+
+/**
+ * Emit a structured debug log record, if OPENASSETIO_RESOLVER debug
+ * output is enabled and the record is not sampled out or rate limited,
+ * e.g.
+ *
+ *   OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_Resolve")
+ *       .field("assetPath", assetPath)
+ *       .field("result", result.GetPathString());
+ *
+ * Field arguments are not evaluated if the record is not emitted.
+ */
+#define OPENASSETIO_RESOLVER_LOG(function) \
+  if (!DebugLog::instance().shouldLog()) { \
+  } else                                   \
+    DebugLogRecord { function }
+
+/**
+ * Process-wide sink for resolver debug log records.
+ *
+ * By default records are written synchronously through TfDebug, so
+ * they interleave with other debug output exactly as TF_DEBUG would.
+ *
+ * If OPENASSETIO_RESOLVER_LOG_ASYNC is set, records are instead copied
+ * into a preallocated, bounded, lock-free ring and written to stdout by
+ * a background thread, so resolver threads never block on output.
+ * Records are dropped, and counted, rather than blocking if the ring
+ * is full.
+ *
+ * Sampling (OPENASSETIO_RESOLVER_LOG_SAMPLE) and rate limiting
+ * (OPENASSETIO_RESOLVER_LOG_RATE_LIMIT) are applied before a record is
+ * formatted, in either mode.
+ */
+class DebugLog {
+ public:
+  /// Maximum size of a formatted record. Longer records are truncated.
+  static constexpr std::size_t kMaxRecordSize = 1024;
+
+  /// The process-wide instance. Never destroyed, so is safe to use
+  /// from other static destructors and exit handlers.
+  static DebugLog &instance();
+
+  /// Whether the next record should be emitted.
+  [[nodiscard]] bool shouldLog() noexcept;
+
+  /// Emit a formatted record.
+  void write(std::string_view record) noexcept;
+
+ private:
+  struct Slot {
+    std::atomic<std::size_t> sequence;
+    std::uint32_t size;
+    std::array<char, kMaxRecordSize> data;
+  };
+  static constexpr std::size_t kSlotCount = 1024;
+
+  DebugLog();
+
+  bool tryPush(std::string_view record) noexcept;
+  void drain(std::FILE *file);
+  void runWriter();
+  static void stopWriter();
+
+  std::uint64_t sampleInterval_;
+  std::uint64_t rateLimit_;
+  std::atomic<std::uint64_t> rateWindow_{0};
+  std::atomic<std::uint64_t> rateWindowCount_{0};
+  std::atomic<std::uint64_t> rateLimited_{0};
+
+  // Ring buffer, only allocated in asynchronous mode. Multiple
+  // producers claim slots by CAS on the enqueue position; the single
+  // writer thread consumes them in order.
+  std::unique_ptr<Slot[]> slots_;  // NOLINT(*-avoid-c-arrays)
+  alignas(64) std::atomic<std::size_t> enqueuePos_{0};
+  alignas(64) std::size_t dequeuePos_{0};
+  std::atomic<std::uint64_t> dropped_{0};
+  std::atomic<bool> writing_{false};
+
+  std::mutex writerMutex_;
+  std::condition_variable writerWakeup_;
+  bool stopping_{false};
+  std::thread writer_;
+};
+
+/**
+ * Formats a single log record into a preallocated per-thread buffer,
+ * without allocating, and hands it to DebugLog when destroyed. Only
+ * one record may be in construction on each thread at a time.
+ *
+ * Records have the same layout as the resolver's TF_DEBUG output:
+ *
+ *   OPENASSETIO_RESOLVER: <function>
+ *     <name>: <value>
+ */
+class DebugLogRecord {
+ public:
+  explicit DebugLogRecord(std::string_view function) noexcept;
+  ~DebugLogRecord();
+
+  DebugLogRecord(const DebugLogRecord &) = delete;
+  DebugLogRecord &operator=(const DebugLogRecord &) = delete;
+
+  DebugLogRecord &field(std::string_view name, std::string_view value) noexcept;
+  DebugLogRecord &field(std::string_view name, std::int64_t value) noexcept;
+  DebugLogRecord &field(std::string_view name, double value) noexcept;
+
+ private:
+  void append(std::string_view str) noexcept;
+
+  char *buffer_;
+  std::size_t size_{0};
+};
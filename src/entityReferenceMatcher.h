@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+
+/**
+ * Classifies asset paths as entity references or plain file paths by
+ * their prefix (e.g. "bal:///").
+ *
+ * The prefix is fixed at construction so that classification is a
+ * length check and a single fixed-size comparison, with no allocation
+ * and no manager involvement. This keeps the cost to plain file paths,
+ * which are the overwhelming majority, negligible.
+ */
+class EntityReferenceMatcher {
+ public:
+  explicit EntityReferenceMatcher(std::string prefix) : prefix_{std::move(prefix)} {}
+
+  [[nodiscard]] bool isEntityReference(std::string_view assetPath) const noexcept {
+    // An empty prefix disables entity reference handling entirely.
+    return !prefix_.empty() && assetPath.size() >= prefix_.size() &&
+           assetPath.front() == prefix_.front() &&
+           std::memcmp(assetPath.data(), prefix_.data(), prefix_.size()) == 0;
+  }
+
+  [[nodiscard]] const std::string &prefix() const noexcept { return prefix_; }
+
+ private:
+  const std::string prefix_;
+};
@@ -0,0 +1,84 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "frequencySketch.h"
+
+#include <algorithm>
+#include <array>
+
+namespace {
+// Per-row seeds, so that each row maps a key to an independent word.
+constexpr std::array<std::uint64_t, 4> kRowSeeds{0x97cb3127b1e3a5c5U, 0x2545f4914f6cdd1dU,
+                                                 0x9e3779b97f4a7c15U, 0xbf58476d1ce4e5b9U};
+
+// splitmix64 finaliser.
+std::uint64_t mix(std::uint64_t value) noexcept {
+  value = (value ^ (value >> 30U)) * 0xbf58476d1ce4e5b9U;
+  value = (value ^ (value >> 27U)) * 0x94d049bb133111ebU;
+  return value ^ (value >> 31U);
+}
+
+std::size_t nextPowerOfTwo(const std::size_t value) noexcept {
+  std::size_t result = 1;
+  while (result < value) {
+    result <<= 1U;
+  }
+  return result;
+}
+}  // namespace
+
+FrequencySketch::FrequencySketch(const std::size_t expectedEntries)
+    : wordMask_{nextPowerOfTwo(std::max<std::size_t>(expectedEntries, 16)) - 1},
+      sampleSize_{10 * std::max<std::uint64_t>(expectedEntries, 16)},
+      words_{std::make_unique<std::atomic<std::uint64_t>[]>(wordMask_ + 1)} {
+  for (std::size_t idx = 0; idx <= wordMask_; ++idx) {
+    words_[idx].store(0, std::memory_order_relaxed);
+  }
+}
+
+void FrequencySketch::increment(const std::size_t hash) noexcept {
+  bool added = false;
+  for (unsigned row = 0; row < kDepth; ++row) {
+    const Counter slot = counter(hash, row);
+    std::atomic<std::uint64_t> &word = words_[slot.word];
+    std::uint64_t current = word.load(std::memory_order_relaxed);
+    while (((current >> slot.shift) & kMaxCount) != kMaxCount) {
+      if (word.compare_exchange_weak(current, current + (std::uint64_t{1} << slot.shift),
+                                     std::memory_order_relaxed)) {
+        added = true;
+        break;
+      }
+    }
+  }
+  // Only the thread that completes the sample ages the counters.
+  if (added && additions_.fetch_add(1, std::memory_order_relaxed) + 1 == sampleSize_) {
+    halve();
+    additions_.store(sampleSize_ / 2, std::memory_order_relaxed);
+  }
+}
+
+unsigned FrequencySketch::frequency(const std::size_t hash) const noexcept {
+  std::uint64_t result = kMaxCount;
+  for (unsigned row = 0; row < kDepth; ++row) {
+    const Counter slot = counter(hash, row);
+    const std::uint64_t word = words_[slot.word].load(std::memory_order_relaxed);
+    result = std::min(result, (word >> slot.shift) & kMaxCount);
+  }
+  return static_cast<unsigned>(result);
+}
+
+FrequencySketch::Counter FrequencySketch::counter(const std::size_t hash,
+                                                  const unsigned row) const noexcept {
+  const std::uint64_t mixed = mix(hash + kRowSeeds[row]);
+  // The low bits pick the word, the top four the counter within it.
+  return {static_cast<std::size_t>(mixed) & wordMask_, static_cast<unsigned>(mixed >> 60U) * 4};
+}
+
+void FrequencySketch::halve() noexcept {
+  // Clear the bit shifted in from each counter's neighbour.
+  constexpr std::uint64_t kHalfMask = 0x7777777777777777U;
+  for (std::size_t idx = 0; idx <= wordMask_; ++idx) {
+    const std::uint64_t word = words_[idx].load(std::memory_order_relaxed);
+    words_[idx].store((word >> 1U) & kHalfMask, std::memory_order_relaxed);
+  }
+}
@@ -0,0 +1,47 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * Approximate recent access frequencies of hashed keys, for cache
+ * admission decisions, as in TinyLFU.
+ *
+ * A count-min sketch of 4-bit counters, packed sixteen to a word, with
+ * four counters per key. Counters saturate at 15, and all are halved
+ * once ten times the expected number of entries have been counted, so
+ * that frequencies decay with age.
+ *
+ * Updates are lock-free, and may race, losing increments. This only
+ * makes the estimates slightly less accurate.
+ */
+class FrequencySketch {
+ public:
+  explicit FrequencySketch(std::size_t expectedEntries);
+
+  void increment(std::size_t hash) noexcept;
+
+  [[nodiscard]] unsigned frequency(std::size_t hash) const noexcept;
+
+ private:
+  static constexpr unsigned kDepth = 4;
+  static constexpr std::uint64_t kMaxCount = 15;
+
+  struct Counter {
+    std::size_t word;
+    unsigned shift;
+  };
+
+  [[nodiscard]] Counter counter(std::size_t hash, unsigned row) const noexcept;
+
+  void halve() noexcept;
+
+  const std::size_t wordMask_;
+  const std::uint64_t sampleSize_;
+  std::unique_ptr<std::atomic<std::uint64_t>[]> words_;
+  std::atomic<std::uint64_t> additions_{0};
+};
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "internedPathMemo.h"
+
+#include <mutex>
+#include <string>
+#include <utility>
+
+#include "budgetedCache.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+constexpr std::size_t kInitialSlotCount = 64;
+}  // namespace
+
+bool InternedPathMemo::find(const std::string_view assetPath, const std::size_t contextHash,
+                            ArResolvedPath &resolvedPath) const {
+  const std::size_t hash = ResolveKey::hash(assetPath, contextHash);
+  const std::shared_lock lock{mutex_};
+  if (slots_.empty()) {
+    return false;
+  }
+  const Slot &slot = slots_[probe(hash, assetPath, contextHash)];
+  if (slot.assetPath == kEmpty) {
+    return false;
+  }
+  resolvedPath = ArResolvedPath{paths_.path(slot.resolvedPath)};
+  return true;
+}
+
+void InternedPathMemo::insert(const std::string_view assetPath, const std::size_t contextHash,
+                              const ArResolvedPath &resolvedPath) {
+  const std::size_t hash = ResolveKey::hash(assetPath, contextHash);
+  const std::unique_lock lock{mutex_};
+  const std::size_t slot = slots_.empty() ? 0 : probe(hash, assetPath, contextHash);
+  if (slots_.empty() || slots_[slot].assetPath == kEmpty) {
+    add(slot, hash, assetPath, contextHash, resolvedPath);
+  } else {
+    slots_[slot].resolvedPath = paths_.intern(resolvedPath.GetPathString());
+  }
+}
+
+ArResolvedPath InternedPathMemo::insertIfAbsent(const std::string_view assetPath,
+                                                const std::size_t contextHash,
+                                                const ArResolvedPath &resolvedPath) {
+  const std::size_t hash = ResolveKey::hash(assetPath, contextHash);
+  const std::unique_lock lock{mutex_};
+  const std::size_t slot = slots_.empty() ? 0 : probe(hash, assetPath, contextHash);
+  if (slots_.empty() || slots_[slot].assetPath == kEmpty) {
+    add(slot, hash, assetPath, contextHash, resolvedPath);
+    return resolvedPath;
+  }
+  return ArResolvedPath{paths_.path(slots_[slot].resolvedPath)};
+}
+
+void InternedPathMemo::forEach(
+    const std::function<void(std::string_view, std::size_t, const ArResolvedPath &)> &func)
+    const {
+  const std::shared_lock lock{mutex_};
+  for (const Slot &slot : slots_) {
+    if (slot.assetPath != kEmpty) {
+      func(paths_.path(slot.assetPath), slot.contextHash,
+           ArResolvedPath{paths_.path(slot.resolvedPath)});
+    }
+  }
+}
+
+void InternedPathMemo::eraseContext(const std::size_t contextHash) {
+  struct Kept {
+    std::size_t hash;
+    std::size_t contextHash;
+    std::string assetPath;
+    std::string resolvedPath;
+  };
+  const std::unique_lock lock{mutex_};
+  std::vector<Kept> kept;
+  bool erased = false;
+  for (const Slot &slot : slots_) {
+    if (slot.assetPath == kEmpty) {
+      continue;
+    }
+    if (slot.contextHash == contextHash) {
+      erased = true;
+    } else {
+      kept.push_back(Kept{slot.hash, slot.contextHash, paths_.path(slot.assetPath),
+                          paths_.path(slot.resolvedPath)});
+    }
+  }
+  if (!erased) {
+    return;
+  }
+  // Emptying slots would break the probe sequences through them, so
+  // the table is rebuilt, also releasing paths only erased entries
+  // used.
+  paths_.clear();
+  slots_.clear();
+  size_ = 0;
+  for (const Kept &entry : kept) {
+    const std::size_t slot =
+        slots_.empty() ? 0 : probe(entry.hash, entry.assetPath, entry.contextHash);
+    add(slot, entry.hash, entry.assetPath, entry.contextHash, ArResolvedPath{entry.resolvedPath});
+  }
+}
+
+void InternedPathMemo::clear() {
+  const std::unique_lock lock{mutex_};
+  paths_.clear();
+  slots_.clear();
+  size_ = 0;
+}
+
+std::size_t InternedPathMemo::size() const {
+  const std::shared_lock lock{mutex_};
+  return size_;
+}
+
+std::size_t InternedPathMemo::memoryBytes() const {
+  const std::shared_lock lock{mutex_};
+  return paths_.memoryBytes() + slots_.capacity() * sizeof(Slot);
+}
+
+std::size_t InternedPathMemo::probe(const std::size_t hash, const std::string_view assetPath,
+                                    const std::size_t contextHash) const {
+  const std::size_t mask = slots_.size() - 1;
+  std::size_t idx = hash & mask;
+  while (slots_[idx].assetPath != kEmpty &&
+         (slots_[idx].hash != hash || slots_[idx].contextHash != contextHash ||
+          !paths_.equals(slots_[idx].assetPath, assetPath))) {
+    idx = (idx + 1) & mask;
+  }
+  return idx;
+}
+
+void InternedPathMemo::add(std::size_t slot, const std::size_t hash,
+                           const std::string_view assetPath, const std::size_t contextHash,
+                           const ArResolvedPath &resolvedPath) {
+  if ((size_ + 1) * 4 > slots_.size() * 3) {
+    std::vector<Slot> previous = std::move(slots_);
+    slots_.assign(previous.empty() ? kInitialSlotCount : previous.size() * 2, Slot{});
+    const std::size_t mask = slots_.size() - 1;
+    // Keys are distinct, so need only an empty slot.
+    for (const Slot &moved : previous) {
+      if (moved.assetPath != kEmpty) {
+        std::size_t idx = moved.hash & mask;
+        while (slots_[idx].assetPath != kEmpty) {
+          idx = (idx + 1) & mask;
+        }
+        slots_[idx] = moved;
+      }
+    }
+    slot = probe(hash, assetPath, contextHash);
+  }
+  slots_[slot] = Slot{hash, contextHash, paths_.intern(assetPath),
+                      paths_.intern(resolvedPath.GetPathString())};
+  ++size_;
+}
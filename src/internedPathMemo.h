@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <shared_mutex>
+#include <string_view>
+#include <vector>
+
+#include <pxr/usd/ar/resolvedPath.h>
+
+#include "pathTrie.h"
+
+/**
+ * Map of (asset path, context hash) to resolved path, for records of
+ * resolutions that are kept for the lifetime of the process, e.g.
+ * version pins and manifest exports.
+ *
+ * Asset paths and resolved paths are interned together in a PathTrie,
+ * so the many paths sharing long prefixes are stored compactly, and
+ * entries are small fixed-size slots of hash and handles, in an
+ * open-addressed table. A lookup probes by the hash of the key, then
+ * checks the asset path against the trie from its handle, so never
+ * descends the trie. Resolved paths are rebuilt from the trie.
+ *
+ * Entries are never evicted, only cleared, whether all together or
+ * those of a context. Lookups share a
+ * reader-writer lock, so may run concurrently.
+ */
+class InternedPathMemo {
+ public:
+  bool find(std::string_view assetPath, std::size_t contextHash,
+            PXR_NS::ArResolvedPath &resolvedPath) const;
+
+  /// Add a resolution, replacing any existing entry for the key.
+  void insert(std::string_view assetPath, std::size_t contextHash,
+              const PXR_NS::ArResolvedPath &resolvedPath);
+
+  /// Add a resolution unless the key already has one, returning the
+  /// resolution now remembered for the key.
+  PXR_NS::ArResolvedPath insertIfAbsent(std::string_view assetPath, std::size_t contextHash,
+                                        const PXR_NS::ArResolvedPath &resolvedPath);
+
+  /// Call the given function with every entry, in no particular order,
+  /// whilst holding a shared lock.
+  void forEach(const std::function<void(std::string_view, std::size_t,
+                                        const PXR_NS::ArResolvedPath &)> &func) const;
+
+  /// Remove every entry of the given context. Linear in the number of
+  /// entries kept, which are added afresh.
+  void eraseContext(std::size_t contextHash);
+
+  void clear();
+
+  [[nodiscard]] std::size_t size() const;
+
+  /// Approximate memory used, in bytes.
+  [[nodiscard]] std::size_t memoryBytes() const;
+
+ private:
+  static constexpr PathTrie::Handle kEmpty = std::numeric_limits<PathTrie::Handle>::max();
+
+  struct Slot {
+    std::size_t hash;
+    std::size_t contextHash;
+    PathTrie::Handle assetPath{kEmpty};
+    PathTrie::Handle resolvedPath;
+  };
+
+  // The slot holding the key, or the empty slot it would go in.
+  [[nodiscard]] std::size_t probe(std::size_t hash, std::string_view assetPath,
+                                  std::size_t contextHash) const;
+
+  // Fill an empty slot, growing the table if needed.
+  void add(std::size_t slot, std::size_t hash, std::string_view assetPath,
+           std::size_t contextHash, const PXR_NS::ArResolvedPath &resolvedPath);
+
+  mutable std::shared_mutex mutex_;
+  PathTrie paths_;
+  // Sized to a power of two, at most 3/4 full.
+  std::vector<Slot> slots_;
+  std::size_t size_{0};
+};
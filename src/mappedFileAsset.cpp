@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "mappedFileAsset.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstring>
+
+#include "pxr/usd/ar/inMemoryAsset.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+struct MappedFileAsset::Mapping {
+  Mapping(const char *mappedData, const std::size_t mappedSize)
+      : data{mappedData}, size{mappedSize} {}
+
+  ~Mapping() {
+    ::munmap(const_cast<char *>(data), size);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+  }
+
+  Mapping(const Mapping &) = delete;
+  Mapping &operator=(const Mapping &) = delete;
+
+  const char *data;
+  std::size_t size;
+};
+
+namespace {
+int madviseFlag(const MappedFileAsset::Advice advice) {
+  switch (advice) {
+    case MappedFileAsset::Advice::kSequential:
+      return MADV_SEQUENTIAL;
+    case MappedFileAsset::Advice::kRandom:
+      return MADV_RANDOM;
+    case MappedFileAsset::Advice::kWillNeed:
+      return MADV_WILLNEED;
+    case MappedFileAsset::Advice::kNormal:
+      break;
+  }
+  return MADV_NORMAL;
+}
+}  // namespace
+
+std::shared_ptr<MappedFileAsset> MappedFileAsset::open(const std::string &path,
+                                                       const Options &options) {
+  FILE *file = std::fopen(path.c_str(), "rbe");
+  if (!file) {
+    return nullptr;
+  }
+  const int fd = ::fileno(file);
+  struct stat info {};
+  // Empty files cannot be mapped.
+  if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0) {
+    std::fclose(file);
+    return nullptr;
+  }
+  const auto size = static_cast<std::size_t>(info.st_size);
+  int flags = MAP_PRIVATE;
+#ifdef MAP_POPULATE
+  if (options.populate) {
+    flags |= MAP_POPULATE;
+  }
+#endif
+  void *data = ::mmap(nullptr, size, PROT_READ, flags, fd, 0);
+  if (data == MAP_FAILED) {  // NOLINT(*-cstyle-cast, performance-no-int-to-ptr)
+    std::fclose(file);
+    return nullptr;
+  }
+  if (options.advice != Advice::kNormal) {
+    // Only a hint, so failure is harmless.
+    ::madvise(data, size, madviseFlag(options.advice));
+  }
+  auto mapping = std::make_shared<const Mapping>(static_cast<const char *>(data), size);
+  // Private constructor, so make_shared is not available.
+  return std::shared_ptr<MappedFileAsset>{
+      new MappedFileAsset(file, std::move(mapping))};  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+MappedFileAsset::MappedFileAsset(FILE *file, std::shared_ptr<const Mapping> mapping)
+    : file_{file}, mapping_{std::move(mapping)} {}
+
+MappedFileAsset::~MappedFileAsset() { std::fclose(file_); }
+
+std::size_t MappedFileAsset::GetSize() const { return mapping_->size; }
+
+std::shared_ptr<const char> MappedFileAsset::GetBuffer() const {
+  // Aliases the mapping, keeping it alive for as long as the buffer.
+  return {mapping_, mapping_->data};
+}
+
+std::size_t MappedFileAsset::Read(void *buffer, const std::size_t count,
+                                  const std::size_t offset) const {
+  if (offset >= mapping_->size) {
+    return 0;
+  }
+  const std::size_t readSize = std::min(count, mapping_->size - offset);
+  std::memcpy(buffer, mapping_->data + offset, readSize);
+  return readSize;
+}
+
+std::pair<FILE *, std::size_t> MappedFileAsset::GetFileUnsafe() const { return {file_, 0}; }
+
+std::shared_ptr<ArAsset> MappedFileAsset::GetDetachedAsset() const {
+  return ArInMemoryAsset::FromAsset(*this);
+}
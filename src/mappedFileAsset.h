@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include <pxr/usd/ar/asset.h>
+
+/**
+ * An ArAsset for a file, mapped into memory once when opened.
+ *
+ * Buffers share ownership of the mapping, so GetBuffer neither copies
+ * nor maps the file again, however often it is called, and reads are
+ * copies from the mapping rather than system calls. The mapping is
+ * released when the asset and every buffer from it are destroyed.
+ *
+ * The file itself is kept open, so that GetFileUnsafe is available to
+ * readers, e.g. the crate reader, that prefer to do their own I/O.
+ *
+ * As with any mapping, the file must not be truncated whilst mapped.
+ */
+class MappedFileAsset final : public PXR_NS::ArAsset {
+ public:
+  /// Kernel hint of how the mapping will be accessed.
+  enum class Advice { kNormal, kSequential, kRandom, kWillNeed };
+
+  struct Options {
+    /// Fault in every page when mapping, rather than on first access.
+    bool populate{false};
+    Advice advice{Advice::kNormal};
+  };
+
+  /// Map a file. Returns nullptr if the file cannot be opened or
+  /// mapped, or is empty, so that the caller can fall back to another
+  /// asset implementation.
+  static std::shared_ptr<MappedFileAsset> open(const std::string &path, const Options &options);
+
+  ~MappedFileAsset() override;
+
+  MappedFileAsset(const MappedFileAsset &) = delete;
+  MappedFileAsset &operator=(const MappedFileAsset &) = delete;
+
+  [[nodiscard]] std::size_t GetSize() const override;
+  [[nodiscard]] std::shared_ptr<const char> GetBuffer() const override;
+  std::size_t Read(void *buffer, std::size_t count, std::size_t offset) const override;
+  [[nodiscard]] std::pair<FILE *, std::size_t> GetFileUnsafe() const override;
+
+  /// A copy of the contents in memory, independent of later changes
+  /// to the file, which a mapping is not.
+  [[nodiscard]] std::shared_ptr<PXR_NS::ArAsset> GetDetachedAsset() const override;
+
+ private:
+  struct Mapping;
+
+  MappedFileAsset(FILE *file, std::shared_ptr<const Mapping> mapping);
+
+  FILE *file_;
+  std::shared_ptr<const Mapping> mapping_;
+};
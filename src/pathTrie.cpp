@@ -0,0 +1,199 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "pathTrie.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace {
+constexpr std::size_t kInitialChildSlotCount = 64;
+
+std::size_t childHash(const PathTrie::Handle parent, const char firstChar) noexcept {
+  std::uint64_t value = (std::uint64_t{parent} << 8U) | static_cast<unsigned char>(firstChar);
+  value = (value ^ (value >> 33U)) * 0xff51afd7ed558ccdU;
+  return value ^ (value >> 33U);
+}
+}  // namespace
+
+PathTrie::PathTrie() { clear(); }
+
+PathTrie::Handle PathTrie::intern(const std::string_view path) {
+  Handle handle = 0;
+  std::string_view remaining = path;
+  while (!remaining.empty()) {
+    const Handle child = children_[probeChild(handle, remaining.front())].child;
+    if (child == kNone) {
+      handle = addChild(handle, remaining);
+      break;
+    }
+    const std::string_view childLabel = label(node(child));
+    const auto mismatch =
+        std::mismatch(childLabel.begin(), childLabel.end(), remaining.begin(), remaining.end());
+    const auto commonSize = static_cast<std::uint32_t>(mismatch.first - childLabel.begin());
+    handle = commonSize < childLabel.size() ? split(child, commonSize) : child;
+    remaining.remove_prefix(commonSize);
+  }
+  if (Node &interned = node(handle); !interned.interned) {
+    interned.interned = true;
+    ++size_;
+  }
+  return handle;
+}
+
+bool PathTrie::find(const std::string_view path, Handle &handle) const {
+  Handle current = 0;
+  std::string_view remaining = path;
+  while (!remaining.empty()) {
+    const Handle child = children_[probeChild(current, remaining.front())].child;
+    if (child == kNone) {
+      return false;
+    }
+    const std::string_view childLabel = label(node(child));
+    if (remaining.compare(0, childLabel.size(), childLabel) != 0) {
+      return false;
+    }
+    current = child;
+    remaining.remove_prefix(childLabel.size());
+  }
+  if (!node(current).interned) {
+    return false;
+  }
+  handle = current;
+  return true;
+}
+
+std::string PathTrie::path(const Handle handle) const {
+  std::size_t size = 0;
+  for (Handle current = handle; current != 0; current = node(current).parent) {
+    size += node(current).labelSize;
+  }
+  // Fill from the end, walking up to the root.
+  std::string result(size, '\0');
+  for (Handle current = handle; current != 0; current = node(current).parent) {
+    const std::string_view nodeLabel = label(node(current));
+    size -= nodeLabel.size();
+    result.replace(size, nodeLabel.size(), nodeLabel);
+  }
+  return result;
+}
+
+bool PathTrie::equals(const Handle handle, std::string_view other) const noexcept {
+  for (Handle current = handle; current != 0; current = node(current).parent) {
+    const std::string_view nodeLabel = label(node(current));
+    if (nodeLabel.size() > other.size() ||
+        other.substr(other.size() - nodeLabel.size()) != nodeLabel) {
+      return false;
+    }
+    other.remove_suffix(nodeLabel.size());
+  }
+  return other.empty();
+}
+
+std::size_t PathTrie::memoryBytes() const noexcept {
+  return nodeBlocks_.size() * (sizeof(Node) << kNodeBlockBits) +
+         (labelBlocks_.size() << kLabelBlockBits) +
+         children_.capacity() * sizeof(ChildSlot);
+}
+
+void PathTrie::clear() {
+  nodeBlocks_.clear();
+  nodeCount_ = 0;
+  labelBlocks_.clear();
+  labelBlockUsed_ = 0;
+  children_.assign(kInitialChildSlotCount, ChildSlot{kNone, kNone});
+  childCount_ = 0;
+  size_ = 0;
+  addNode(Node{0, 0, 0, '\0', false});
+}
+
+const PathTrie::Node &PathTrie::node(const Handle handle) const noexcept {
+  return nodeBlocks_[handle >> kNodeBlockBits][handle & ((1U << kNodeBlockBits) - 1)];
+}
+
+PathTrie::Node &PathTrie::node(const Handle handle) noexcept {
+  return nodeBlocks_[handle >> kNodeBlockBits][handle & ((1U << kNodeBlockBits) - 1)];
+}
+
+std::string_view PathTrie::label(const Node &labelled) const noexcept {
+  const std::uint32_t block = labelled.labelOffset >> kLabelBlockBits;
+  const std::uint32_t offset = labelled.labelOffset & ((1U << kLabelBlockBits) - 1);
+  return {labelBlocks_[block].get() + offset, labelled.labelSize};
+}
+
+std::uint32_t PathTrie::storeLabel(const std::string_view newLabel) {
+  constexpr std::size_t kBlockSize = std::size_t{1} << kLabelBlockBits;
+  // Labels never straddle blocks. One longer than a block, which no
+  // real path is, gets a block of its own.
+  if (labelBlocks_.empty() || labelBlockUsed_ + newLabel.size() > kBlockSize) {
+    labelBlocks_.emplace_back(new char[std::max(kBlockSize, newLabel.size())]);
+    labelBlockUsed_ = 0;
+  }
+  const auto offset =
+      static_cast<std::uint32_t>(((labelBlocks_.size() - 1) << kLabelBlockBits) | labelBlockUsed_);
+  std::memcpy(labelBlocks_.back().get() + labelBlockUsed_, newLabel.data(), newLabel.size());
+  labelBlockUsed_ += newLabel.size();
+  return offset;
+}
+
+PathTrie::Handle PathTrie::addNode(const Node &newNode) {
+  if ((nodeCount_ >> kNodeBlockBits) == nodeBlocks_.size()) {
+    nodeBlocks_.emplace_back(new Node[std::size_t{1} << kNodeBlockBits]);
+  }
+  const auto handle = static_cast<Handle>(nodeCount_++);
+  node(handle) = newNode;
+  return handle;
+}
+
+std::size_t PathTrie::probeChild(const Handle parent, const char firstChar) const noexcept {
+  const std::size_t mask = children_.size() - 1;
+  std::size_t idx = childHash(parent, firstChar) & mask;
+  while (children_[idx].child != kNone &&
+         (children_[idx].parent != parent || node(children_[idx].child).firstChar != firstChar)) {
+    idx = (idx + 1) & mask;
+  }
+  return idx;
+}
+
+void PathTrie::setChild(const Handle parent, const Handle child) {
+  if ((childCount_ + 1) * 4 > children_.size() * 3) {
+    std::vector<ChildSlot> previous = std::move(children_);
+    children_.assign(previous.size() * 2, ChildSlot{kNone, kNone});
+    for (const ChildSlot &slot : previous) {
+      if (slot.child != kNone) {
+        children_[probeChild(slot.parent, node(slot.child).firstChar)] = slot;
+      }
+    }
+  }
+  ChildSlot &slot = children_[probeChild(parent, node(child).firstChar)];
+  if (slot.child == kNone) {
+    ++childCount_;
+  }
+  slot = ChildSlot{parent, child};
+}
+
+PathTrie::Handle PathTrie::addChild(const Handle parent, const std::string_view childLabel) {
+  const Handle child = addNode(Node{storeLabel(childLabel),
+                                    static_cast<std::uint32_t>(childLabel.size()), parent,
+                                    childLabel.front(), false});
+  setChild(parent, child);
+  return child;
+}
+
+PathTrie::Handle PathTrie::split(const Handle handle, const std::uint32_t prefixSize) {
+  const Node original = node(handle);
+  const Handle prefix =
+      addNode(Node{original.labelOffset, prefixSize, original.parent, original.firstChar, false});
+
+  // The prefix node takes the node's place as its parent's child, and
+  // the node, now labelled with the rest, becomes the prefix's child.
+  setChild(original.parent, prefix);
+  Node &suffix = node(handle);
+  suffix.labelOffset += prefixSize;
+  suffix.labelSize -= prefixSize;
+  suffix.firstChar = label(suffix).front();
+  suffix.parent = prefix;
+  setChild(prefix, handle);
+  return prefix;
+}
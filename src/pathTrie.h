@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Interning pool of paths, stored as a radix tree.
+ *
+ * Each edge is labelled with a run of characters, and each distinct
+ * prefix shared by interned paths is stored once, so paths sharing
+ * long prefixes, e.g. resolved paths under the same show root, cost
+ * little more than their distinct suffixes. Labels are slices of a
+ * character pool, so splitting an edge copies no characters.
+ *
+ * Interned paths are identified by stable handles, valid until the
+ * trie is cleared. A lookup compares each label once, finding each
+ * child with a single probe of a hash table keyed by parent and first
+ * character. Callers that already hold a candidate handle, e.g. from
+ * their own hash of the path, can instead check it with `equals`,
+ * which is cheaper than descending from the root.
+ *
+ * Nodes and labels are allocated in fixed-size blocks, so growth
+ * neither copies them nor leaves half-used capacity.
+ *
+ * Not thread-safe.
+ */
+class PathTrie {
+ public:
+  using Handle = std::uint32_t;
+
+  PathTrie();
+
+  /// Intern a path, returning its handle, the same for equal paths.
+  Handle intern(std::string_view path);
+
+  /// Look up the handle of a path, returning false if not interned.
+  bool find(std::string_view path, Handle &handle) const;
+
+  /// The interned path with the given handle.
+  [[nodiscard]] std::string path(Handle handle) const;
+
+  /// Whether the interned path with the given handle equals a path,
+  /// compared from the end without rebuilding the interned path.
+  [[nodiscard]] bool equals(Handle handle, std::string_view path) const noexcept;
+
+  /// The number of distinct paths interned.
+  [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+  /// Approximate memory used, in bytes.
+  [[nodiscard]] std::size_t memoryBytes() const noexcept;
+
+  void clear();
+
+ private:
+  // Marks an empty child slot. The root is never a child.
+  static constexpr Handle kNone = 0;
+  static constexpr unsigned kNodeBlockBits = 16;
+  static constexpr unsigned kLabelBlockBits = 20;
+
+  struct Node {
+    std::uint32_t labelOffset;
+    std::uint32_t labelSize;
+    Handle parent;
+    // The first character of the label, telling apart children whose
+    // slots collide.
+    char firstChar;
+    bool interned;
+  };
+
+  struct ChildSlot {
+    Handle parent;
+    Handle child;
+  };
+
+  [[nodiscard]] const Node &node(Handle handle) const noexcept;
+  Node &node(Handle handle) noexcept;
+
+  [[nodiscard]] std::string_view label(const Node &node) const noexcept;
+
+  // Copy a label into the pool, returning its offset.
+  std::uint32_t storeLabel(std::string_view label);
+
+  Handle addNode(const Node &node);
+
+  // The slot holding the child of a parent starting with the given
+  // character, or the empty slot it would go in.
+  [[nodiscard]] std::size_t probeChild(Handle parent, char firstChar) const noexcept;
+
+  void setChild(Handle parent, Handle child);
+
+  Handle addChild(Handle parent, std::string_view label);
+
+  // Split the label of a node after the given number of characters,
+  // returning the new node for the first part, whose child the node
+  // becomes. The node's handle, and so path, are unchanged.
+  Handle split(Handle handle, std::uint32_t prefixSize);
+
+  std::vector<std::unique_ptr<Node[]>> nodeBlocks_;
+  std::size_t nodeCount_{0};
+  std::vector<std::unique_ptr<char[]>> labelBlocks_;
+  std::size_t labelBlockUsed_{0};
+  // Open-addressed, sized to a power of two, at most 3/4 full.
+  std::vector<ChildSlot> children_;
+  std::size_t childCount_{0};
+  std::size_t size_{0};
+};
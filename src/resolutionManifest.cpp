@@ -0,0 +1,393 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "resolutionManifest.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <numeric>
+
+#include "pxr/base/tf/diagnostic.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+struct ResolutionManifest::Header {
+  std::array<char, 8> magic;
+  std::uint64_t seed;
+  std::uint64_t entryCount;
+  std::uint64_t slotCount;
+  std::uint64_t bucketCount;
+  std::uint64_t displacementsOffset;
+  std::uint64_t slotsOffset;
+  std::uint64_t poolOffset;
+  std::uint64_t poolSize;
+};
+
+struct ResolutionManifest::Slot {
+  std::uint64_t keyOffset;
+  std::uint64_t valueOffset;
+  std::uint32_t keySize;
+  std::uint32_t valueSize;
+};
+
+namespace {
+constexpr std::string_view kMagic{"OAIOMAN2"};
+
+// Average keys per bucket. Lower values make the index slightly
+// larger, but much quicker to build.
+constexpr std::size_t kKeysPerBucket = 2;
+// Spare slots, as a fraction of keys plus a constant, since placing
+// the last buckets into the last free slots of a table with no spare
+// takes many more displacements and seeds.
+constexpr std::size_t kKeysPerSpareSlot = 99;
+constexpr std::size_t kSpareSlots = 16;
+// Displacements to try for a bucket before starting again with a new
+// seed.
+constexpr std::uint32_t kMaxDisplacement = 1U << 20U;
+constexpr std::uint64_t kMaxSeed = 64;
+
+constexpr std::uint64_t kGoldenRatio = 0x9e3779b97f4a7c15ULL;
+
+// splitmix64 finaliser.
+std::uint64_t mix(std::uint64_t value) noexcept {
+  value ^= value >> 30U;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27U;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31U;
+  return value;
+}
+
+// FNV-1a, which, unlike std::hash, is stable between builds.
+std::uint64_t fnv1a(const std::string_view str) noexcept {
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const char chr : str) {
+    hash ^= static_cast<unsigned char>(chr);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+
+struct KeyHash {
+  std::uint64_t bucket;
+  std::uint64_t slot;
+};
+
+KeyHash keyHash(const std::string_view key, const std::uint64_t seed) noexcept {
+  const std::uint64_t hash = fnv1a(key) ^ mix(seed);
+  return {mix(hash), mix(hash ^ kGoldenRatio)};
+}
+
+std::uint64_t slotIndex(const std::uint64_t slotHash, const std::uint32_t displacement,
+                        const std::uint64_t slotCount) noexcept {
+  return mix(slotHash + displacement * kGoldenRatio) % slotCount;
+}
+
+std::uint64_t alignUp(const std::uint64_t offset) noexcept { return (offset + 7U) & ~7ULL; }
+
+// Search for a displacement per bucket that maps every key to its own
+// slot, returning false if none can be found for some bucket.
+bool buildIndex(const std::vector<KeyHash> &hashes, const std::uint64_t slotCount,
+                std::vector<std::uint32_t> &displacements, std::vector<std::uint64_t> &slotOfKey) {
+  const std::size_t bucketCount = displacements.size();
+
+  std::vector<std::vector<std::size_t>> buckets(bucketCount);
+  for (std::size_t key = 0; key < hashes.size(); ++key) {
+    buckets[hashes[key].bucket % bucketCount].push_back(key);
+  }
+  // Place the largest buckets first, whilst there are most free slots.
+  std::vector<std::size_t> order(bucketCount);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&buckets](std::size_t lhs, std::size_t rhs) {
+    return buckets[lhs].size() > buckets[rhs].size();
+  });
+
+  std::vector<bool> occupied(slotCount, false);
+  std::vector<std::uint64_t> candidate;
+  for (const std::size_t bucket : order) {
+    const std::vector<std::size_t> &keys = buckets[bucket];
+    if (keys.empty()) {
+      break;
+    }
+    bool placed = false;
+    for (std::uint32_t displacement = 0; displacement < kMaxDisplacement && !placed;
+         ++displacement) {
+      candidate.clear();
+      placed = true;
+      for (const std::size_t key : keys) {
+        const std::uint64_t slot = slotIndex(hashes[key].slot, displacement, slotCount);
+        if (occupied[slot] ||
+            std::find(candidate.begin(), candidate.end(), slot) != candidate.end()) {
+          placed = false;
+          break;
+        }
+        candidate.push_back(slot);
+      }
+      if (placed) {
+        displacements[bucket] = displacement;
+        for (std::size_t idx = 0; idx < keys.size(); ++idx) {
+          occupied[candidate[idx]] = true;
+          slotOfKey[keys[idx]] = candidate[idx];
+        }
+      }
+    }
+    if (!placed) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+// ------------------------------------------------------------
+/* ResolutionManifest */
+std::unique_ptr<ResolutionManifest> ResolutionManifest::open(const std::string &path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);  // NOLINT(*-vararg)
+  if (fd < 0) {
+    TF_WARN("Failed to open resolution manifest '%s': %s", path.c_str(), std::strerror(errno));
+    return nullptr;
+  }
+  struct stat info {};
+  if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(Header)) {
+    ::close(fd);
+    TF_WARN("'%s' is not a resolution manifest", path.c_str());
+    return nullptr;
+  }
+  const auto size = static_cast<std::size_t>(info.st_size);
+  void *data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {  // NOLINT(*-cstyle-cast, performance-no-int-to-ptr)
+    TF_WARN("Failed to map resolution manifest '%s': %s", path.c_str(), std::strerror(errno));
+    return nullptr;
+  }
+  // Private constructor, so make_unique is not available.
+  std::unique_ptr<ResolutionManifest> manifest{
+      new ResolutionManifest(static_cast<const char *>(data), size)};  // NOLINT
+
+  // Validate the layout up front, so lookups need only check that
+  // each slot's strings are within the pool.
+  const Header &header = *manifest->header_;
+  const auto fits = [size](const std::uint64_t offset, const std::uint64_t count,
+                           const std::uint64_t elementSize) {
+    return offset <= size && count <= (size - offset) / elementSize;
+  };
+  if (std::string_view{header.magic.data(), header.magic.size()} != kMagic ||
+      (header.slotCount == 0) != (header.bucketCount == 0) ||
+      header.entryCount > header.slotCount ||
+      !fits(header.displacementsOffset, header.bucketCount, sizeof(std::uint32_t)) ||
+      !fits(header.slotsOffset, header.slotCount, sizeof(Slot)) ||
+      !fits(header.poolOffset, header.poolSize, 1) || header.displacementsOffset % 8 != 0 ||
+      header.slotsOffset % 8 != 0) {
+    TF_WARN("'%s' is not a resolution manifest", path.c_str());
+    return nullptr;
+  }
+  manifest->displacements_ =
+      reinterpret_cast<const std::uint32_t *>(manifest->data_ + header.displacementsOffset);
+  manifest->slots_ = reinterpret_cast<const Slot *>(manifest->data_ + header.slotsOffset);
+  manifest->pool_ = manifest->data_ + header.poolOffset;
+  return manifest;
+}
+
+ResolutionManifest::ResolutionManifest(const char *data, const std::size_t size)
+    : data_{data},
+      size_{size},
+      header_{reinterpret_cast<const Header *>(data)},
+      displacements_{nullptr},
+      slots_{nullptr},
+      pool_{nullptr} {}
+
+ResolutionManifest::~ResolutionManifest() {
+  ::munmap(const_cast<char *>(data_), size_);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+}
+
+bool ResolutionManifest::find(const std::string_view assetPath,
+                              std::string_view &resolvedPath) const noexcept {
+  if (header_->slotCount == 0) {
+    return false;
+  }
+  const KeyHash hash = keyHash(assetPath, header_->seed);
+  const std::uint32_t displacement = displacements_[hash.bucket % header_->bucketCount];
+  const Slot &slot = slots_[slotIndex(hash.slot, displacement, header_->slotCount)];
+  if (slot.keySize == 0) {
+    // A spare slot, which no key maps to.
+    return false;
+  }
+
+  const std::uint64_t poolSize = header_->poolSize;
+  if (slot.keyOffset > poolSize || slot.keySize > poolSize - slot.keyOffset ||
+      slot.valueOffset > poolSize || slot.valueSize > poolSize - slot.valueOffset) {
+    return false;
+  }
+  // Keys not in the manifest still map to some slot, so the key must
+  // be compared.
+  if (std::string_view{pool_ + slot.keyOffset, slot.keySize} != assetPath) {
+    return false;
+  }
+  resolvedPath = {pool_ + slot.valueOffset, slot.valueSize};
+  return true;
+}
+
+std::size_t ResolutionManifest::size() const noexcept { return header_->entryCount; }
+
+void ResolutionManifest::forEach(
+    const std::function<void(std::string_view, std::string_view)> &func) const {
+  const std::uint64_t poolSize = header_->poolSize;
+  for (std::uint64_t idx = 0; idx < header_->slotCount; ++idx) {
+    const Slot &slot = slots_[idx];
+    if (slot.keySize == 0 || slot.keyOffset > poolSize ||
+        slot.keySize > poolSize - slot.keyOffset || slot.valueOffset > poolSize ||
+        slot.valueSize > poolSize - slot.valueOffset) {
+      continue;
+    }
+    func({pool_ + slot.keyOffset, slot.keySize}, {pool_ + slot.valueOffset, slot.valueSize});
+  }
+}
+
+bool ResolutionManifest::write(const std::string &path,
+                               std::vector<std::pair<std::string, std::string>> entries) {
+  static_assert(sizeof(Header) == 72);
+  static_assert(sizeof(Slot) == 24);
+
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+  const auto sameKey = [](const auto &lhs, const auto &rhs) { return lhs.first == rhs.first; };
+  entries.erase(std::unique(entries.begin(), entries.end(), sameKey), entries.end());
+  // An empty key marks a spare slot, and never resolves anyway.
+  if (!entries.empty() && entries.front().first.empty()) {
+    entries.erase(entries.begin());
+  }
+
+  Header header{};
+  std::copy(kMagic.begin(), kMagic.end(), header.magic.begin());
+  header.entryCount = entries.size();
+  header.slotCount =
+      entries.empty() ? 0 : entries.size() + entries.size() / kKeysPerSpareSlot + kSpareSlots;
+  header.bucketCount = entries.empty() ? 0 : entries.size() / kKeysPerBucket + 1;
+
+  std::vector<std::uint32_t> displacements(header.bucketCount);
+  std::vector<std::uint64_t> slotOfKey(entries.size());
+  if (!entries.empty()) {
+    std::vector<KeyHash> hashes(entries.size());
+    for (; header.seed < kMaxSeed; ++header.seed) {
+      for (std::size_t key = 0; key < entries.size(); ++key) {
+        hashes[key] = keyHash(entries[key].first, header.seed);
+      }
+      if (buildIndex(hashes, header.slotCount, displacements, slotOfKey)) {
+        break;
+      }
+    }
+    if (header.seed == kMaxSeed) {
+      TF_WARN("Failed to build index for resolution manifest '%s'", path.c_str());
+      return false;
+    }
+  }
+
+  std::vector<Slot> slots(header.slotCount);
+  std::string pool;
+  for (std::size_t key = 0; key < entries.size(); ++key) {
+    const auto &[assetPath, resolvedPath] = entries[key];
+    Slot &slot = slots[slotOfKey[key]];
+    slot.keyOffset = pool.size();
+    slot.keySize = static_cast<std::uint32_t>(assetPath.size());
+    pool += assetPath;
+    slot.valueOffset = pool.size();
+    slot.valueSize = static_cast<std::uint32_t>(resolvedPath.size());
+    pool += resolvedPath;
+  }
+
+  header.displacementsOffset = sizeof(Header);
+  header.slotsOffset =
+      alignUp(header.displacementsOffset + displacements.size() * sizeof(std::uint32_t));
+  header.poolOffset = header.slotsOffset + slots.size() * sizeof(Slot);
+  header.poolSize = pool.size();
+
+  // Write to a temporary file and rename, so that readers never map a
+  // partially written manifest.
+  const std::string tmpPath = path + ".tmp";
+  std::FILE *file = std::fopen(tmpPath.c_str(), "wb");
+  if (!file) {
+    TF_WARN("Failed to open resolution manifest '%s' for writing: %s", tmpPath.c_str(),
+            std::strerror(errno));
+    return false;
+  }
+  const std::array<char, 8> padding{};
+  const std::size_t paddingSize = header.slotsOffset - header.displacementsOffset -
+                                  displacements.size() * sizeof(std::uint32_t);
+  const bool written =
+      std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+      std::fwrite(displacements.data(), sizeof(std::uint32_t), displacements.size(), file) ==
+          displacements.size() &&
+      std::fwrite(padding.data(), 1, paddingSize, file) == paddingSize &&
+      std::fwrite(slots.data(), sizeof(Slot), slots.size(), file) ==
+          slots.size() &&
+      std::fwrite(pool.data(), 1, pool.size(), file) == pool.size();
+  if (std::fclose(file) != 0 || !written || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+    TF_WARN("Failed to write resolution manifest '%s'", path.c_str());
+    std::remove(tmpPath.c_str());
+    return false;
+  }
+  return true;
+}
+
+// ------------------------------------------------------------
+/* ResolutionRecorder */
+ResolutionRecorder &ResolutionRecorder::instance() {
+  // Deliberately leaked, see header.
+  static auto *const instance = new ResolutionRecorder;  // NOLINT(cppcoreguidelines-owning-memory)
+  return *instance;
+}
+
+void ResolutionRecorder::record(const std::string_view assetPath,
+                                const std::string_view resolvedPath) {
+  resolutions_.insertIfAbsent(assetPath, 0, ArResolvedPath{std::string{resolvedPath}});
+}
+
+bool ResolutionRecorder::write(const std::string &path) const {
+  std::vector<std::pair<std::string, std::string>> entries;
+  resolutions_.forEach([&entries](const std::string_view assetPath, std::size_t /*contextHash*/,
+                                  const ArResolvedPath &resolvedPath) {
+    entries.emplace_back(assetPath, resolvedPath.GetPathString());
+  });
+  return ResolutionManifest::write(path, std::move(entries));
+}
+
+void ResolutionRecorder::writeAtExit(std::string path) {
+  const std::lock_guard lock{exitPathMutex_};
+  if (exitPath_.empty()) {
+    std::atexit(&ResolutionRecorder::writeOnExit);
+  }
+  exitPath_ = std::move(path);
+}
+
+void ResolutionRecorder::writeOnExit() {
+  ResolutionRecorder &recorder = instance();
+  const std::lock_guard lock{recorder.exitPathMutex_};
+  recorder.write(recorder.exitPath_);
+}
+
+// ------------------------------------------------------------
+/* C API */
+int UsdOpenAssetIOResolverWriteManifest(const char *path) {
+  return ResolutionRecorder::instance().write(path) ? 1 : 0;
+}
+
+int UsdOpenAssetIOResolverWriteManifestEntries(const char *path, const std::size_t count,
+                                               const char *const *assetPaths,
+                                               const char *const *resolvedPaths) {
+  std::vector<std::pair<std::string, std::string>> entries;
+  entries.reserve(count);
+  for (std::size_t idx = 0; idx < count; ++idx) {
+    entries.emplace_back(assetPaths[idx], resolvedPaths[idx]);
+  }
+  return ResolutionManifest::write(path, std::move(entries)) ? 1 : 0;
+}
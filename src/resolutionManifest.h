@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "internedPathMemo.h"
+
+/**
+ * A read-only, memory-mapped table of entity reference resolutions,
+ * for resolving without querying a manager.
+ *
+ * The file is a header followed by a perfect hash index
+ * (hash-and-displace: one displacement per bucket of keys, mapping
+ * every key to a distinct slot), an array of slots, a few more than
+ * there are keys so that the index builds quickly, and a pool of the
+ * key and value strings the slots point into. A lookup hashes the key
+ * once, reads one displacement and one slot, and compares the key.
+ *
+ * The file is mapped rather than read, so opening is O(1) regardless
+ * of size and pages are shared between processes on the same host.
+ * Integers are stored in host byte order.
+ */
+class ResolutionManifest {
+ public:
+  /// Map a manifest file. Returns nullptr, with a warning, if the file
+  /// cannot be mapped or is not a valid manifest.
+  static std::unique_ptr<ResolutionManifest> open(const std::string &path);
+
+  /// Write a manifest of the given (entity reference, resolved path)
+  /// pairs, replacing any existing file. Where an entity reference is
+  /// given more than once, the first is kept. Returns false, with a
+  /// warning, on failure.
+  static bool write(const std::string &path,
+                    std::vector<std::pair<std::string, std::string>> entries);
+
+  ~ResolutionManifest();
+
+  ResolutionManifest(const ResolutionManifest &) = delete;
+  ResolutionManifest &operator=(const ResolutionManifest &) = delete;
+
+  /// Look up the resolved path of an entity reference. The result
+  /// points into the mapping, so is valid for the manifest's lifetime.
+  bool find(std::string_view assetPath, std::string_view &resolvedPath) const noexcept;
+
+  [[nodiscard]] std::size_t size() const noexcept;
+
+  /// Call the given function with every (entity reference, resolved
+  /// path) pair, in no particular order.
+  void forEach(const std::function<void(std::string_view, std::string_view)> &func) const;
+
+ private:
+  struct Header;
+  struct Slot;
+
+  ResolutionManifest(const char *data, std::size_t size);
+
+  const char *data_;
+  std::size_t size_;
+  const Header *header_;
+  const std::uint32_t *displacements_;
+  const Slot *slots_;
+  const char *pool_;
+};
+
+/**
+ * Process-wide record of the entity reference resolutions made, for
+ * exporting as a manifest. Paths are interned, as a recording session
+ * may make millions of resolutions sharing a few long prefixes.
+ */
+class ResolutionRecorder {
+ public:
+  /// The process-wide instance. Never destroyed, so is safe to use
+  /// from exit handlers.
+  static ResolutionRecorder &instance();
+
+  void record(std::string_view assetPath, std::string_view resolvedPath);
+
+  /// Write the recorded resolutions as a manifest.
+  bool write(const std::string &path) const;
+
+  /// Write the recorded resolutions as a manifest when the process
+  /// exits.
+  void writeAtExit(std::string path);
+
+ private:
+  ResolutionRecorder() = default;
+
+  static void writeOnExit();
+
+  InternedPathMemo resolutions_;
+  std::mutex exitPathMutex_;
+  std::string exitPath_;
+};
+
+/**
+ * C entry points for writing manifests from Python via ctypes. See
+ * CallStats for loading the plugin library. Return non-zero on
+ * success.
+ */
+extern "C" {
+/// Write the resolutions recorded so far in this process. Recording
+/// is enabled by setting OPENASSETIO_RESOLVER_MANIFEST_EXPORT.
+int UsdOpenAssetIOResolverWriteManifest(const char *path);
+
+/// Write a manifest of the given resolutions.
+int UsdOpenAssetIOResolverWriteManifestEntries(const char *path, std::size_t count,
+                                               const char *const *assetPaths,
+                                               const char *const *resolvedPaths);
+}
@@ -0,0 +1,111 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "resolutionRevalidator.h"
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+ResolutionRevalidator::ResolutionRevalidator(ResolvedPathCache &cache,
+                                             const std::chrono::milliseconds interval,
+                                             Resolve resolve)
+    : cache_{cache},
+      interval_{interval},
+      resolve_{std::move(resolve)},
+      worker_{&ResolutionRevalidator::run, this} {}
+
+ResolutionRevalidator::~ResolutionRevalidator() {
+  {
+    const std::lock_guard lock{stopMutex_};
+    stopping_ = true;
+  }
+  stopWakeup_.notify_one();
+  worker_.join();
+}
+
+void ResolutionRevalidator::addContext(const std::size_t contextHash,
+                                       const ArResolverContext &context) {
+  const std::lock_guard lock{contextsMutex_};
+  contexts_.try_emplace(contextHash, context);
+}
+
+std::size_t ResolutionRevalidator::check() {
+  const std::lock_guard passLock{passMutex_};
+
+  // Snapshot the entries first, so that no cache lock is held whilst
+  // resolving, which may be slow.
+  std::vector<Change> entries;
+  cache_.forEach([&entries](const std::string_view assetPath, const std::size_t contextHash,
+                            const ArResolvedPath &resolvedPath) {
+    entries.push_back(Change{std::string{assetPath}, contextHash, {}, resolvedPath, {}});
+  });
+  {
+    // Without its context, an entry would be resolved in the wrong one.
+    const std::lock_guard lock{contextsMutex_};
+    entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                 [this](Change &entry) {
+                                   const auto iter = contexts_.find(entry.contextHash);
+                                   if (iter == contexts_.end()) {
+                                     return true;
+                                   }
+                                   entry.context = iter->second;
+                                   return false;
+                                 }),
+                  entries.end());
+  }
+
+  for (Change &entry : entries) {
+    ArResolvedPath resolvedPath;
+    if (!resolve_(entry.assetPath, entry.context, resolvedPath)) {
+      continue;
+    }
+    ResolveKey key{entry.assetPath, entry.contextHash};
+    const std::lock_guard lock{changesMutex_};
+    if (resolvedPath == entry.basePath) {
+      // Any change held back has since been reverted.
+      changes_.erase(key);
+    } else {
+      entry.resolvedPath = std::move(resolvedPath);
+      changes_.insert_or_assign(std::move(key), std::move(entry));
+    }
+  }
+  const std::lock_guard lock{changesMutex_};
+  return changes_.size();
+}
+
+std::vector<ResolutionRevalidator::Change> ResolutionRevalidator::apply() {
+  std::unordered_map<ResolveKey, Change, ResolveKey::Hash> changes;
+  {
+    const std::lock_guard lock{changesMutex_};
+    changes.swap(changes_);
+  }
+  std::vector<Change> applied;
+  for (auto &[key, change] : changes) {
+    ArResolvedPath cached;
+    // Otherwise a newer resolution would be replaced by an older one.
+    if (!cache_.find(key.assetPath, key.contextHash, cached) || cached != change.basePath) {
+      continue;
+    }
+    cache_.insert(key.assetPath, key.contextHash, change.resolvedPath);
+    applied.push_back(std::move(change));
+  }
+  return applied;
+}
+
+void ResolutionRevalidator::discard() {
+  const std::lock_guard lock{changesMutex_};
+  changes_.clear();
+}
+
+void ResolutionRevalidator::run() {
+  std::unique_lock lock{stopMutex_};
+  while (!stopWakeup_.wait_for(lock, interval_, [this] { return stopping_; })) {
+    lock.unlock();
+    check();
+    lock.lock();
+  }
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <pxr/usd/ar/resolvedPath.h>
+#include <pxr/usd/ar/resolverContext.h>
+
+#include "resolvedPathCache.h"
+
+/**
+ * Re-resolves the entries of a ResolvedPathCache on a background
+ * thread, so that cached resolutions can be served immediately whilst
+ * changes, e.g. newly published versions, are still picked up.
+ *
+ * Every interval, each cached entry is resolved again in the context
+ * it was first resolved in. Entries whose resolution changed are held
+ * back until the client applies them, on a thread of its choosing, so
+ * that the cache only changes when the client is ready to be notified,
+ * e.g. in the main thread's idle loop rather than mid-composition.
+ */
+class ResolutionRevalidator {
+ public:
+  /// Resolve an asset path again, returning false to leave the cached
+  /// resolution as it is, e.g. if the query failed.
+  using Resolve = std::function<bool(const std::string &assetPath,
+                                     const PXR_NS::ArResolverContext &context,
+                                     PXR_NS::ArResolvedPath &resolvedPath)>;
+
+  struct Change {
+    std::string assetPath;
+    std::size_t contextHash{};
+    PXR_NS::ArResolverContext context;
+    // The cached resolution the change was found against.
+    PXR_NS::ArResolvedPath basePath;
+    PXR_NS::ArResolvedPath resolvedPath;
+  };
+
+  /// Start revalidating the given cache, which must outlive this
+  /// object.
+  ResolutionRevalidator(ResolvedPathCache &cache, std::chrono::milliseconds interval,
+                        Resolve resolve);
+
+  /// Stop revalidating, waiting for any pass in progress to finish.
+  ~ResolutionRevalidator();
+
+  ResolutionRevalidator(const ResolutionRevalidator &) = delete;
+  ResolutionRevalidator &operator=(const ResolutionRevalidator &) = delete;
+
+  /// Remember the context that entries with the given context hash
+  /// are resolved in. Only the first context given for a hash is kept.
+  void addContext(std::size_t contextHash, const PXR_NS::ArResolverContext &context);
+
+  /// Resolve every entry again now, on the calling thread, holding
+  /// back those that changed until applied. Entries of contexts never
+  /// added are skipped. Returns the number of changes held back.
+  std::size_t check();
+
+  /// Update the cache with the changes held back, returning them.
+  /// Changes to entries no longer cached as they were when checked,
+  /// e.g. since removed or resolved afresh, are dropped.
+  std::vector<Change> apply();
+
+  /// Drop the changes held back, e.g. when the cache is cleared on a
+  /// context refresh. Changes found by a pass in progress are still
+  /// dropped on apply, as the entries they were found against are
+  /// gone.
+  void discard();
+
+ private:
+  void run();
+
+  ResolvedPathCache &cache_;
+  const std::chrono::milliseconds interval_;
+  const Resolve resolve_;
+
+  std::mutex contextsMutex_;
+  std::unordered_map<std::size_t, PXR_NS::ArResolverContext> contexts_;
+
+  // Serialises passes, should check() be called whilst the
+  // background thread is mid-pass.
+  std::mutex passMutex_;
+
+  std::mutex changesMutex_;
+  std::unordered_map<ResolveKey, Change, ResolveKey::Hash> changes_;
+
+  std::mutex stopMutex_;
+  std::condition_variable stopWakeup_;
+  bool stopping_{false};
+  std::thread worker_;
+};
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "resolveDaemonClient.h"
+
+#include <utility>
+
+ResolveDaemonClient::ResolveDaemonClient(std::string socketPath)
+    : socketPath_{std::move(socketPath)} {}
+
+bool ResolveDaemonClient::resolve(const std::vector<std::string> &searchPath,
+                                  const std::vector<std::string_view> &assetPaths,
+                                  std::vector<std::string> &resolvedPaths) {
+  std::unique_ptr<ResolveDaemonConnection> connection = takeConnection();
+  if (!connection) {
+    return false;
+  }
+  // A failed connection is dropped, the next resolve connecting anew.
+  if (!connection->sendRequest(searchPath, assetPaths) ||
+      !connection->receiveResponse(resolvedPaths) || resolvedPaths.size() != assetPaths.size()) {
+    return false;
+  }
+  returnConnection(std::move(connection));
+  return true;
+}
+
+std::unique_ptr<ResolveDaemonConnection> ResolveDaemonClient::takeConnection() {
+  {
+    const std::lock_guard lock{mutex_};
+    if (!idle_.empty()) {
+      std::unique_ptr<ResolveDaemonConnection> connection = std::move(idle_.back());
+      idle_.pop_back();
+      return connection;
+    }
+  }
+  const Clock::time_point now = Clock::now();
+  if (now.time_since_epoch().count() < retryAfter_.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  std::unique_ptr<ResolveDaemonConnection> connection =
+      ResolveDaemonConnection::connect(socketPath_);
+  if (!connection) {
+    retryAfter_.store((now + kRetryInterval).time_since_epoch().count(),
+                      std::memory_order_relaxed);
+  }
+  return connection;
+}
+
+void ResolveDaemonClient::returnConnection(
+    std::unique_ptr<ResolveDaemonConnection> connection) {
+  const std::lock_guard lock{mutex_};
+  idle_.push_back(std::move(connection));
+}
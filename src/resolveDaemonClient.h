@@ -0,0 +1,50 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "resolveDaemonConnection.h"
+
+/**
+ * Forwards batches of entity references to the resolve daemon, which
+ * hosts a single, warm manager and caches for every process on the
+ * host, rather than each process starting its own manager.
+ *
+ * Connections are pooled, so concurrent resolves from many threads
+ * each use their own connection, reused by later resolves. If the
+ * daemon cannot be reached, resolves fail, so that the caller can
+ * resolve in process, and no further connection is attempted for a
+ * short while, so that a missing daemon costs little.
+ */
+class ResolveDaemonClient {
+ public:
+  explicit ResolveDaemonClient(std::string socketPath);
+
+  /// Resolve a batch of asset paths in the context of the given search
+  /// path. Unresolved asset paths give empty resolved paths. Returns
+  /// false if the daemon could not be reached or failed to reply.
+  bool resolve(const std::vector<std::string> &searchPath,
+               const std::vector<std::string_view> &assetPaths,
+               std::vector<std::string> &resolvedPaths);
+
+ private:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr Clock::duration kRetryInterval = std::chrono::seconds{1};
+
+  std::unique_ptr<ResolveDaemonConnection> takeConnection();
+  void returnConnection(std::unique_ptr<ResolveDaemonConnection> connection);
+
+  const std::string socketPath_;
+  std::mutex mutex_;
+  std::vector<std::unique_ptr<ResolveDaemonConnection>> idle_;
+  // Time before which connecting is not retried, as ticks of Clock.
+  std::atomic<Clock::rep> retryAfter_{0};
+};
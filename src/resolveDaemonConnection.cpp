@@ -0,0 +1,162 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "resolveDaemonConnection.h"
+
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+
+namespace {
+constexpr std::size_t kSizeBytes = sizeof(std::uint64_t);
+// Generous, as the daemon may be querying a slow manager.
+constexpr time_t kTimeoutSeconds = 60;
+
+template <class Strings>
+void appendStrings(std::string &payload, const Strings &strings) {
+  const auto count = static_cast<std::uint32_t>(strings.size());
+  payload.append(reinterpret_cast<const char *>(&count), sizeof(count));
+  for (const auto &str : strings) {
+    const auto size = static_cast<std::uint32_t>(str.size());
+    payload.append(reinterpret_cast<const char *>(&size), sizeof(size));
+    payload.append(str.data(), str.size());
+  }
+}
+
+// Read a string list from the front of the payload, consuming it.
+bool consumeStrings(std::string_view &payload, std::vector<std::string> &strings) {
+  std::uint32_t count = 0;
+  if (payload.size() < sizeof(count)) {
+    return false;
+  }
+  std::memcpy(&count, payload.data(), sizeof(count));
+  payload.remove_prefix(sizeof(count));
+  // Each string takes at least its size, so a larger count is bogus.
+  if (count > payload.size() / sizeof(std::uint32_t)) {
+    return false;
+  }
+  strings.clear();
+  strings.reserve(count);
+  for (std::uint32_t idx = 0; idx < count; ++idx) {
+    std::uint32_t size = 0;
+    if (payload.size() < sizeof(size)) {
+      return false;
+    }
+    std::memcpy(&size, payload.data(), sizeof(size));
+    payload.remove_prefix(sizeof(size));
+    if (payload.size() < size) {
+      return false;
+    }
+    strings.emplace_back(payload.substr(0, size));
+    payload.remove_prefix(size);
+  }
+  return true;
+}
+}  // namespace
+
+std::unique_ptr<ResolveDaemonConnection> ResolveDaemonConnection::connect(
+    const std::string &socketPath) {
+  sockaddr_un address{};
+  if (socketPath.size() >= sizeof(address.sun_path)) {
+    return nullptr;
+  }
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+
+  const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return nullptr;
+  }
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0) {
+    ::close(fd);
+    return nullptr;
+  }
+  const timeval timeout{kTimeoutSeconds, 0};
+  ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+  return std::make_unique<ResolveDaemonConnection>(fd);
+}
+
+ResolveDaemonConnection::ResolveDaemonConnection(const int fd) : fd_{fd} {}
+
+ResolveDaemonConnection::~ResolveDaemonConnection() { ::close(fd_); }
+
+bool ResolveDaemonConnection::sendRequest(const std::vector<std::string> &searchPath,
+                                          const std::vector<std::string_view> &assetPaths) {
+  std::string payload(kSizeBytes, '\0');
+  appendStrings(payload, searchPath);
+  appendStrings(payload, assetPaths);
+  return send(payload);
+}
+
+bool ResolveDaemonConnection::receiveRequest(std::vector<std::string> &searchPath,
+                                             std::vector<std::string> &assetPaths) {
+  std::string payload;
+  if (!receive(payload)) {
+    return false;
+  }
+  std::string_view remaining{payload};
+  return consumeStrings(remaining, searchPath) && consumeStrings(remaining, assetPaths) &&
+         remaining.empty();
+}
+
+bool ResolveDaemonConnection::sendResponse(const std::vector<std::string> &resolvedPaths) {
+  std::string payload(kSizeBytes, '\0');
+  appendStrings(payload, resolvedPaths);
+  return send(payload);
+}
+
+bool ResolveDaemonConnection::receiveResponse(std::vector<std::string> &resolvedPaths) {
+  std::string payload;
+  if (!receive(payload)) {
+    return false;
+  }
+  std::string_view remaining{payload};
+  return consumeStrings(remaining, resolvedPaths) && remaining.empty();
+}
+
+bool ResolveDaemonConnection::send(std::string &message) {
+  const std::uint64_t size = message.size() - kSizeBytes;
+  std::memcpy(message.data(), &size, kSizeBytes);
+  std::size_t written = 0;
+  while (written < message.size()) {
+    const ssize_t count =
+        ::send(fd_, message.data() + written, message.size() - written, MSG_NOSIGNAL);
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count <= 0) {
+      return false;
+    }
+    written += static_cast<std::size_t>(count);
+  }
+  return true;
+}
+
+bool ResolveDaemonConnection::receive(std::string &payload) {
+  const auto readAll = [this](char *data, const std::size_t size) {
+    std::size_t read = 0;
+    while (read < size) {
+      const ssize_t count = ::recv(fd_, data + read, size - read, 0);
+      if (count < 0 && errno == EINTR) {
+        continue;
+      }
+      if (count <= 0) {
+        return false;
+      }
+      read += static_cast<std::size_t>(count);
+    }
+    return true;
+  };
+  std::uint64_t size = 0;
+  if (!readAll(reinterpret_cast<char *>(&size), sizeof(size)) || size > kMaxPayloadBytes) {
+    return false;
+  }
+  payload.resize(size);
+  return readAll(payload.data(), payload.size());
+}
@@ -0,0 +1,60 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * A connection over a Unix domain socket between a resolver and the
+ * resolve daemon (see tools/resolveDaemon.cpp), and the messages
+ * exchanged over it.
+ *
+ * A request is the search path of the client's resolver context,
+ * followed by a batch of asset paths. The response is the resolved
+ * path of each, empty if unresolved, in the same order. Each message
+ * is a 64-bit payload size, then the payload, a sequence of string
+ * lists, each a 32-bit count then, for each string, a 32-bit size and
+ * the characters. Integers are in host byte order, since both ends
+ * are on the same host.
+ *
+ * Every method returns false if the connection fails, times out or
+ * carries a malformed message, after which it should be discarded.
+ */
+class ResolveDaemonConnection {
+ public:
+  /// Connect to the daemon listening at the given socket path, or
+  /// return nullptr.
+  static std::unique_ptr<ResolveDaemonConnection> connect(const std::string &socketPath);
+
+  /// Take ownership of a connected socket.
+  explicit ResolveDaemonConnection(int fd);
+  ~ResolveDaemonConnection();
+
+  ResolveDaemonConnection(const ResolveDaemonConnection &) = delete;
+  ResolveDaemonConnection &operator=(const ResolveDaemonConnection &) = delete;
+
+  bool sendRequest(const std::vector<std::string> &searchPath,
+                   const std::vector<std::string_view> &assetPaths);
+
+  bool receiveRequest(std::vector<std::string> &searchPath, std::vector<std::string> &assetPaths);
+
+  bool sendResponse(const std::vector<std::string> &resolvedPaths);
+
+  bool receiveResponse(std::vector<std::string> &resolvedPaths);
+
+ private:
+  // Bound on the payload size accepted, so that a malformed message
+  // cannot exhaust memory.
+  static constexpr std::uint64_t kMaxPayloadBytes = std::uint64_t{256} << 20U;
+
+  // Send a message, its payload preceded by space for the size.
+  bool send(std::string &message);
+  bool receive(std::string &payload);
+
+  const int fd_;
+};
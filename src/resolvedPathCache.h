@@ -0,0 +1,22 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstddef>
+
+#include <pxr/usd/ar/resolvedPath.h>
+
+#include "budgetedCache.h"
+
+template <>
+struct BudgetedCacheTraits<PXR_NS::ArResolvedPath> {
+  static std::size_t heapBytes(const PXR_NS::ArResolvedPath &resolvedPath) noexcept {
+    return resolvedPath.GetPathString().capacity();
+  }
+};
+
+/**
+ * Process-wide cache of resolved paths, shared by all threads. See
+ * BudgetedCache.
+ */
+using ResolvedPathCache = BudgetedCache<PXR_NS::ArResolvedPath>;
@@ -3,13 +3,29 @@
 
 #include "resolver.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string_view>
 #include <utility>
+#include <vector>
 
-#include "pxr/base/tf/debug.h"
 #include "pxr/base/tf/diagnostic.h"
+#include "pxr/base/tf/envSetting.h"
+#include "pxr/base/trace/trace.h"
 #include "pxr/usd/ar/assetInfo.h"
 #include "pxr/usd/ar/defaultResolver.h"
+#include "pxr/usd/ar/defaultResolverContext.h"
 #include "pxr/usd/ar/defineResolver.h"
+#include "pxr/usd/ar/inMemoryAsset.h"
+#include "pxr/usd/ar/notice.h"
+#include "pxr/usd/ar/packageUtils.h"
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/ar/resolverContextBinder.h"
+
+#include "callStats.h"
+#include "callTrace.h"
+#include "debugLog.h"
 
 // NOLINTNEXTLINE
 PXR_NAMESPACE_USING_DIRECTIVE
@@ -17,107 +33,1110 @@ PXR_NAMESPACE_OPEN_SCOPE
 
 AR_DEFINE_RESOLVER(UsdOpenAssetIOResolver, ArResolver)
 
-TF_DEBUG_CODES(OPENASSETIO_RESOLVER)
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_ENTITY_REFERENCE_PREFIX, "bal:///",
+                      "Prefix identifying asset paths as entity references. Paths "
+                      "without it are handled exactly as by ArDefaultResolver.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_TRACE_FILE, "",
+                      "Path of a file to record every resolver call to, for later "
+                      "replay. Disabled if empty.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_CALL_STATS, true,
+                      "Accumulate call counts and latency histograms for each "
+                      "resolver method.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_CALL_STATS_FILE, "",
+                      "Path of a file to write resolver call stats to, as JSON, on "
+                      "process exit. Use '-' for stderr. Disabled if empty.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_RESOLVED_PATH_CACHE, true,
+                      "Remember entity reference resolutions for the lifetime of the "
+                      "process, or until the resolver context is refreshed.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_CACHE_ASSET_METADATA, false,
+                      "Also remember the asset info and modification timestamps of "
+                      "entity references, as for their resolutions. Only safe if the "
+                      "files they resolve to are never rewritten in place, as layers "
+                      "would then not be reloaded.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_CACHE_BUDGET_MB, 256,
+                      "Memory budget, in MiB, of the resolved path, asset info and "
+                      "timestamp caches, between them. Unbounded if 0.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_MANIFEST, "",
+                      "Path of a resolution manifest to resolve entity references "
+                      "from, in preference to querying the manager. Disabled if empty.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_MANIFEST_EXPORT, "",
+                      "Path of a file to write a resolution manifest of every entity "
+                      "reference resolved to, on process exit. Disabled if empty.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_THREAD_RESOLVE_CACHE, true,
+                      "Remember recent entity reference resolutions on each thread, "
+                      "until a cache scope ends or the resolver context is refreshed. "
+                      "Always disabled along with the resolved path cache.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_PIN_VERSIONS, false,
+                      "Pin the first resolution of each entity reference in each "
+                      "resolver context until the context is refreshed, so floating "
+                      "versions resolve consistently.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_VERSION_PINS, "",
+                      "Path of a resolution manifest of version pins to load, "
+                      "enabling version pinning. Disabled if empty.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_VERSION_PINS_EXPORT, "",
+                      "Path of a file to write the version pins to, as a resolution "
+                      "manifest, on process exit, enabling version pinning. Disabled "
+                      "if empty.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_REVALIDATE_INTERVAL_MS, 0,
+                      "Interval, in milliseconds, at which cached entity reference "
+                      "resolutions are re-resolved in the background. Changes are "
+                      "applied, and ArNotice::ResolverChanged sent, when the client "
+                      "calls UsdOpenAssetIOResolverRevalidate. Disabled if 0.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_UNRESOLVED_CACHE_TTL_MS, 0,
+                      "Time, in milliseconds, to remember that an asset path failed "
+                      "to resolve, rather than resolving it again. Disabled if 0.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_UNRESOLVED_CACHE_SIZE, 65536,
+                      "Maximum number of asset paths remembered as failing to "
+                      "resolve.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_MMAP_ASSETS, false,
+                      "Open file assets by memory-mapping them once, so buffers "
+                      "share the mapping rather than each mapping or copying the file.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_MMAP_POPULATE, false,
+                      "Fault in every page of memory-mapped assets when opened, "
+                      "rather than on first access.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_MMAP_ADVICE, "",
+                      "Access pattern hint for memory-mapped assets: 'sequential', "
+                      "'random' or 'willneed'. None if empty.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_ASSET_CACHE_MB, 0,
+                      "Memory budget, in MiB, of a cache of the contents of opened "
+                      "files, so files opened again are not read again. Disabled if 0.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_SHARED_CACHE, "",
+                      "Name of a POSIX shared memory segment in which to share entity "
+                      "reference resolutions with other processes on the host. "
+                      "Disabled if empty.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_SHARED_CACHE_MB, 256,
+                      "Size, in MiB, of the shared memory segment, if this process "
+                      "creates it.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_SHARED_CACHE_ASSETS, false,
+                      "Also share the contents of opened files through the shared "
+                      "memory segment.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_DAEMON_SOCKET, "",
+                      "Path of the Unix domain socket of a resolve daemon to forward "
+                      "entity reference queries to, rather than querying the manager "
+                      "in process. Disabled if empty.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_LOCALIZE_MOUNTS, "",
+                      "Colon-separated mount points of slow, e.g. network, storage, "
+                      "whose files are opened from copies on local disk. Disabled if "
+                      "empty.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_LOCALIZE_DIR, "",
+                      "Local directory to copy files on slow mount points to.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_LOCALIZE_MB, 102400,
+                      "Disk budget, in MiB, of the local copies of files on slow mount "
+                      "points.")
+
+TF_DEFINE_ENV_SETTING(OPENASSETIO_RESOLVER_LOCALIZE_THREADS, 8,
+                      "Number of threads copying files from slow mount points.")
 
 PXR_NAMESPACE_CLOSE_SCOPE
 
+namespace {
+// Magic bytes at the start of a text (usda) layer.
+constexpr std::string_view kUsdaMagic{"#usda"};
+
+bool isTextLayer(const ArAsset &asset) {
+  char magic[kUsdaMagic.size()];
+  return asset.Read(magic, sizeof(magic), 0) == sizeof(magic) &&
+         std::string_view{magic, sizeof(magic)} == kUsdaMagic;
+}
+
+// Gather the unique entity references authored as asset paths (i.e.
+// `@bal:///...@`) in the contents of a text layer.
+std::vector<std::string> findEntityReferences(std::string_view text,
+                                              const EntityReferenceMatcher &matcher) {
+  std::vector<std::string> entityReferences;
+  if (matcher.prefix().empty()) {
+    return entityReferences;
+  }
+  std::string_view::size_type pos = 0;
+  while ((pos = text.find(matcher.prefix(), pos)) != std::string_view::npos) {
+    const auto end = text.find('@', pos);
+    if (end == std::string_view::npos) {
+      break;
+    }
+    if (pos > 0 && text[pos - 1] == '@') {
+      entityReferences.emplace_back(text.substr(pos, end - pos));
+    }
+    pos = end;
+  }
+  std::sort(entityReferences.begin(), entityReferences.end());
+  entityReferences.erase(std::unique(entityReferences.begin(), entityReferences.end()),
+                         entityReferences.end());
+  return entityReferences;
+}
+
+std::vector<std::string> splitMountPoints(const std::string &mountPoints) {
+  std::vector<std::string> result;
+  std::string::size_type pos = 0;
+  while (pos <= mountPoints.size()) {
+    const auto end = std::min(mountPoints.find(':', pos), mountPoints.size());
+    if (end > pos) {
+      result.push_back(mountPoints.substr(pos, end - pos));
+    }
+    pos = end + 1;
+  }
+  return result;
+}
+
+// Packages (e.g. usdz) are localized whole.
+std::string packageOrFilePath(const std::string &resolvedPath) {
+  return ArIsPackageRelativePath(resolvedPath)
+             ? ArSplitPackageRelativePathOuter(resolvedPath).first
+             : resolvedPath;
+}
+
+// As UsdOpenAssetIOResolver::currentContextHash, for a given context.
+std::size_t contextHashOf(const ArResolverContext &context) {
+  const auto *defaultContext = context.Get<ArDefaultResolverContext>();
+  return defaultContext ? hash_value(*defaultContext) : 0;
+}
+
+MappedFileAsset::Options mappedAssetOptions() {
+  MappedFileAsset::Options options;
+  options.populate = TfGetEnvSetting(OPENASSETIO_RESOLVER_MMAP_POPULATE);
+  if (const std::string &advice = TfGetEnvSetting(OPENASSETIO_RESOLVER_MMAP_ADVICE);
+      advice == "sequential") {
+    options.advice = MappedFileAsset::Advice::kSequential;
+  } else if (advice == "random") {
+    options.advice = MappedFileAsset::Advice::kRandom;
+  } else if (advice == "willneed") {
+    options.advice = MappedFileAsset::Advice::kWillNeed;
+  } else if (!advice.empty()) {
+    TF_WARN("Ignoring unknown OPENASSETIO_RESOLVER_MMAP_ADVICE '%s'", advice.c_str());
+  }
+  return options;
+}
+}  // namespace
+
 // ------------------------------------------------------------
 /* Ar Resolver Implementation */
-UsdOpenAssetIOResolver::UsdOpenAssetIOResolver() {
-  TF_DEBUG(OPENASSETIO_RESOLVER).Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() + "\n");
+UsdOpenAssetIOResolver::UsdOpenAssetIOResolver()
+    : entityReferenceMatcher_{TfGetEnvSetting(OPENASSETIO_RESOLVER_ENTITY_REFERENCE_PREFIX)} {
+  if (const std::string &traceFile = TfGetEnvSetting(OPENASSETIO_RESOLVER_TRACE_FILE);
+      !traceFile.empty()) {
+    callTraceWriter_ = CallTraceWriter::open(traceFile);
+  }
+  if (const std::string &exportFile = TfGetEnvSetting(OPENASSETIO_RESOLVER_MANIFEST_EXPORT);
+      !exportFile.empty()) {
+    resolutionRecorder_ = &ResolutionRecorder::instance();
+    resolutionRecorder_->writeAtExit(exportFile);
+  }
+  const std::string &pinsFile = TfGetEnvSetting(OPENASSETIO_RESOLVER_VERSION_PINS);
+  const std::string &pinsExportFile = TfGetEnvSetting(OPENASSETIO_RESOLVER_VERSION_PINS_EXPORT);
+  if (TfGetEnvSetting(OPENASSETIO_RESOLVER_PIN_VERSIONS) || !pinsFile.empty() ||
+      !pinsExportFile.empty()) {
+    versionPins_ = &VersionPins::instance();
+    if (!pinsExportFile.empty()) {
+      versionPins_->writeAtExit(pinsExportFile);
+    }
+  }
+  if (TfGetEnvSetting(OPENASSETIO_RESOLVER_RESOLVED_PATH_CACHE)) {
+    const int budgetMb = std::max(0, TfGetEnvSetting(OPENASSETIO_RESOLVER_CACHE_BUDGET_MB));
+    const std::size_t budgetBytes = static_cast<std::size_t>(budgetMb) << 20U;
+    CacheStatsRegistry &registry = CacheStatsRegistry::instance();
+    if (TfGetEnvSetting(OPENASSETIO_RESOLVER_CACHE_ASSET_METADATA)) {
+      // Resolved paths are looked up most often, so get half the budget.
+      resolvedPathCache_ = std::make_unique<ResolvedPathCache>(budgetBytes / 2);
+      assetInfoCache_ = std::make_unique<AssetInfoCache>(budgetBytes / 4);
+      timestampCache_ = std::make_unique<TimestampCache>(budgetBytes / 4);
+      cacheStatsIds_ = {
+          registry.add("assetInfo", [this] { return assetInfoCache_->stats(); }),
+          registry.add("timestamps", [this] { return timestampCache_->stats(); }),
+      };
+    } else {
+      resolvedPathCache_ = std::make_unique<ResolvedPathCache>(budgetBytes);
+    }
+    cacheStatsIds_.push_back(
+        registry.add("resolvedPaths", [this] { return resolvedPathCache_->stats(); }));
+  }
+  if (const int ttlMs = TfGetEnvSetting(OPENASSETIO_RESOLVER_UNRESOLVED_CACHE_TTL_MS);
+      ttlMs > 0) {
+    unresolvedPathCache_ = std::make_unique<UnresolvedPathCache>(
+        std::chrono::milliseconds{ttlMs},
+        static_cast<std::size_t>(
+            std::max(1, TfGetEnvSetting(OPENASSETIO_RESOLVER_UNRESOLVED_CACHE_SIZE))));
+  }
+  if (TfGetEnvSetting(OPENASSETIO_RESOLVER_MMAP_ASSETS)) {
+    mappedAssetOptions_ = mappedAssetOptions();
+  }
+  if (const int assetCacheMb = TfGetEnvSetting(OPENASSETIO_RESOLVER_ASSET_CACHE_MB);
+      assetCacheMb > 0) {
+    assetBufferCache_ =
+        std::make_unique<AssetBufferCache>(static_cast<std::size_t>(assetCacheMb) << 20U);
+    cacheStatsIds_.push_back(CacheStatsRegistry::instance().add(
+        "assetBuffers", [this] { return assetBufferCache_->stats(); }));
+  }
+  shareAssets_ = !TfGetEnvSetting(OPENASSETIO_RESOLVER_SHARED_CACHE).empty() &&
+                 TfGetEnvSetting(OPENASSETIO_RESOLVER_SHARED_CACHE_ASSETS);
+  if (const std::string &daemonSocket = TfGetEnvSetting(OPENASSETIO_RESOLVER_DAEMON_SOCKET);
+      !daemonSocket.empty()) {
+    daemonClient_ = std::make_unique<ResolveDaemonClient>(daemonSocket);
+  }
+  if (std::vector<std::string> mountPoints =
+          splitMountPoints(TfGetEnvSetting(OPENASSETIO_RESOLVER_LOCALIZE_MOUNTS));
+      !mountPoints.empty()) {
+    if (const std::string &localizeDir = TfGetEnvSetting(OPENASSETIO_RESOLVER_LOCALIZE_DIR);
+        localizeDir.empty()) {
+      TF_WARN("OPENASSETIO_RESOLVER_LOCALIZE_MOUNTS is set without "
+              "OPENASSETIO_RESOLVER_LOCALIZE_DIR, so files will not be localized");
+    } else {
+      const int budgetMb = std::max(1, TfGetEnvSetting(OPENASSETIO_RESOLVER_LOCALIZE_MB));
+      assetLocalizer_ = AssetLocalizer::open(
+          localizeDir, std::move(mountPoints), static_cast<std::size_t>(budgetMb) << 20U,
+          static_cast<std::size_t>(
+              std::max(1, TfGetEnvSetting(OPENASSETIO_RESOLVER_LOCALIZE_THREADS))));
+    }
+    if (assetLocalizer_) {
+      cacheStatsIds_.push_back(CacheStatsRegistry::instance().add(
+          "localized", [this] { return assetLocalizer_->stats(); }));
+    }
+  }
+  // Each thread's cache is in front of the process-wide one, so must
+  // not remember resolutions that are to be queried afresh.
+  if (resolvedPathCache_ && TfGetEnvSetting(OPENASSETIO_RESOLVER_THREAD_RESOLVE_CACHE)) {
+    threadResolveCacheOwner_ = ThreadResolveCache::newOwnerId();
+  }
+  if (TfGetEnvSetting(OPENASSETIO_RESOLVER_CALL_STATS)) {
+    callStats_ = &CallStats::instance();
+    if (const std::string &statsFile = TfGetEnvSetting(OPENASSETIO_RESOLVER_CALL_STATS_FILE);
+        !statsFile.empty()) {
+      callStats_->dumpAtExit(statsFile);
+    }
+  }
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::UsdOpenAssetIOResolver");
 }
 
 UsdOpenAssetIOResolver::~UsdOpenAssetIOResolver() {
-  TF_DEBUG(OPENASSETIO_RESOLVER).Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() + "\n");
+  for (const std::uint64_t cacheStatsId : cacheStatsIds_) {
+    CacheStatsRegistry::instance().remove(cacheStatsId);
+  }
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::~UsdOpenAssetIOResolver");
+}
+
+void UsdOpenAssetIOResolver::initDeferredState() const {
+  std::call_once(deferredStateInit_, [this] {
+    if (const std::string &manifestFile = TfGetEnvSetting(OPENASSETIO_RESOLVER_MANIFEST);
+        !manifestFile.empty()) {
+      resolutionManifest_ = ResolutionManifest::open(manifestFile);
+    }
+    if (const std::string &pinsFile = TfGetEnvSetting(OPENASSETIO_RESOLVER_VERSION_PINS);
+        versionPins_ && !pinsFile.empty()) {
+      versionPins_->load(pinsFile);
+    }
+    if (const std::string &sharedCacheName =
+            TfGetEnvSetting(OPENASSETIO_RESOLVER_SHARED_CACHE);
+        !sharedCacheName.empty()) {
+      const int sizeMb = std::max(1, TfGetEnvSetting(OPENASSETIO_RESOLVER_SHARED_CACHE_MB));
+      sharedCache_ =
+          SharedResolutionCache::open(sharedCacheName, static_cast<std::size_t>(sizeMb) << 20U);
+      if (sharedCache_) {
+        cacheStatsIds_.push_back(CacheStatsRegistry::instance().add(
+            "shared", [this] { return sharedCache_->stats(); }));
+      }
+    }
+    // Pinned resolutions never change, so need no revalidation.
+    if (const int intervalMs = TfGetEnvSetting(OPENASSETIO_RESOLVER_REVALIDATE_INTERVAL_MS);
+        intervalMs > 0 && resolvedPathCache_ && !versionPins_) {
+      revalidator_ = std::make_unique<ResolutionRevalidator>(
+          *resolvedPathCache_, std::chrono::milliseconds{intervalMs},
+          [this](const std::string &assetPath, const ArResolverContext &context,
+                 ArResolvedPath &resolvedPath) {
+            return requeryEntityReference(assetPath, context, resolvedPath);
+          });
+    }
+    deferredStateReady_.store(true, std::memory_order_release);
+  });
 }
 
 std::string UsdOpenAssetIOResolver::_CreateIdentifier(
     const std::string &assetPath, const ArResolvedPath &anchorAssetPath) const {
-  auto result = ArDefaultResolver::_CreateIdentifier(assetPath, anchorAssetPath);
-  TF_DEBUG(OPENASSETIO_RESOLVER)
-      .Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() + "\n  assetPath: " + assetPath +
-           "\n  anchorAssetPath: " + anchorAssetPath.GetPathString() + "\n  result: " + result +
-           "\n");
+  TRACE_FUNCTION();
+  const auto start = startCall();
+  std::string result;
+  // Entity references are already absolute identifiers, and must not be
+  // anchored as if they were relative file paths.
+  if (entityReferenceMatcher_.isEntityReference(assetPath)) {
+    result = assetPath;
+  } else {
+    TRACE_SCOPE("ArDefaultResolver::_CreateIdentifier");
+    result = ArDefaultResolver::_CreateIdentifier(assetPath, anchorAssetPath);
+  }
+  endCall(ResolverMethod::kCreateIdentifier, start, assetPath, anchorAssetPath.GetPathString(),
+          result);
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_CreateIdentifier")
+      .field("assetPath", assetPath)
+      .field("anchorAssetPath", anchorAssetPath.GetPathString())
+      .field("result", result);
   return result;
 }
 
 std::string UsdOpenAssetIOResolver::_CreateIdentifierForNewAsset(
     const std::string &assetPath, const ArResolvedPath &anchorAssetPath) const {
-  auto result = ArDefaultResolver::_CreateIdentifierForNewAsset(assetPath, anchorAssetPath);
-  TF_DEBUG(OPENASSETIO_RESOLVER)
-      .Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() + "\n  assetPath: " + assetPath +
-           "\n  anchorAssetPath: " + anchorAssetPath.GetPathString() + "\n  result: " + result +
-           "\n");
+  TRACE_FUNCTION();
+  const auto start = startCall();
+  std::string result;
+  if (entityReferenceMatcher_.isEntityReference(assetPath)) {
+    result = assetPath;
+  } else {
+    TRACE_SCOPE("ArDefaultResolver::_CreateIdentifierForNewAsset");
+    result = ArDefaultResolver::_CreateIdentifierForNewAsset(assetPath, anchorAssetPath);
+  }
+  endCall(ResolverMethod::kCreateIdentifierForNewAsset, start, assetPath,
+          anchorAssetPath.GetPathString(), result);
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_CreateIdentifierForNewAsset")
+      .field("assetPath", assetPath)
+      .field("anchorAssetPath", anchorAssetPath.GetPathString())
+      .field("result", result);
   return result;
 }
 
 ArResolvedPath UsdOpenAssetIOResolver::_Resolve(const std::string &assetPath) const {
-  auto result = ArDefaultResolver::_Resolve(assetPath);
-  TF_DEBUG(OPENASSETIO_RESOLVER)
-      .Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() + "\n  assetPath: " + assetPath +
-           "\n  result: " + result.GetPathString() + "\n");
+  TRACE_FUNCTION();
+  const auto start = startCall();
+  ArResolvedPath result;
+  if (entityReferenceMatcher_.isEntityReference(assetPath)) {
+    result = resolveEntityReference(assetPath);
+  } else {
+    result = resolveFilePath(assetPath);
+  }
+  // Start copying files on slow mounts before they are opened.
+  if (assetLocalizer_ && !result.IsEmpty()) {
+    if (const std::string filePath = packageOrFilePath(result.GetPathString());
+        assetLocalizer_->handles(filePath)) {
+      assetLocalizer_->prefetch(filePath);
+    }
+  }
+  endCall(ResolverMethod::kResolve, start, assetPath, {}, result.GetPathString());
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_Resolve")
+      .field("assetPath", assetPath)
+      .field("result", result.GetPathString());
   return result;
 }
 
 ArResolvedPath UsdOpenAssetIOResolver::_ResolveForNewAsset(const std::string &assetPath) const {
-  auto result = ArDefaultResolver::_ResolveForNewAsset(assetPath);
-  TF_DEBUG(OPENASSETIO_RESOLVER)
-      .Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() + "\n  assetPath: " + assetPath +
-           "\n  result: " + result.GetPathString() + "\n");
+  TRACE_FUNCTION();
+  const auto start = startCall();
+  ArResolvedPath result;
+  {
+    TRACE_SCOPE("ArDefaultResolver::_ResolveForNewAsset");
+    result = ArDefaultResolver::_ResolveForNewAsset(assetPath);
+  }
+  // The asset is about to be created, so must no longer be found to
+  // be missing.
+  if (unresolvedPathCache_) {
+    unresolvedPathCache_->erase(assetPath, currentContextHash());
+  }
+  endCall(ResolverMethod::kResolveForNewAsset, start, assetPath, {}, result.GetPathString());
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_ResolveForNewAsset")
+      .field("assetPath", assetPath)
+      .field("result", result.GetPathString());
   return result;
 }
 
 /* Asset Operations*/
 std::string UsdOpenAssetIOResolver::_GetExtension(const std::string &assetPath) const {
-  auto result = ArDefaultResolver::_GetExtension(assetPath);
-  TF_DEBUG(OPENASSETIO_RESOLVER)
-      .Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() + "\n  assetPath: " + assetPath +
-           "\n  result: " + result + "\n");
+  TRACE_FUNCTION();
+  const auto start = startCall();
+  std::string result;
+  {
+    TRACE_SCOPE("ArDefaultResolver::_GetExtension");
+    result = ArDefaultResolver::_GetExtension(assetPath);
+  }
+  endCall(ResolverMethod::kGetExtension, start, assetPath, {}, result);
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_GetExtension")
+      .field("assetPath", assetPath)
+      .field("result", result);
   return result;
 }
 
 ArAssetInfo UsdOpenAssetIOResolver::_GetAssetInfo(const std::string &assetPath,
                                                   const ArResolvedPath &resolvedPath) const {
-  auto result = ArDefaultResolver::_GetAssetInfo(assetPath, resolvedPath);
-  TF_DEBUG(OPENASSETIO_RESOLVER)
-      .Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() + "\n  assetPath: " + assetPath +
-           "\n  resolvedPath :" + resolvedPath.GetPathString() + "\n  result(assetName): " +
-           result.assetName + "\n  result(repoPath): " + result.repoPath + "\n");
+  TRACE_FUNCTION();
+  const auto start = startCall();
+  ArAssetInfo result;
+  const bool cacheable = assetInfoCache_ && entityReferenceMatcher_.isEntityReference(assetPath);
+  CachedAssetInfo cached;
+  if (cacheable && assetInfoCache_->find(assetPath, 0, cached) &&
+      cached.resolvedPath == resolvedPath) {
+    result = std::move(cached.info);
+  } else {
+    {
+      TRACE_SCOPE("ArDefaultResolver::_GetAssetInfo");
+      result = ArDefaultResolver::_GetAssetInfo(assetPath, resolvedPath);
+    }
+    if (cacheable) {
+      assetInfoCache_->insert(assetPath, 0, CachedAssetInfo{resolvedPath, result});
+    }
+  }
+  endCall(ResolverMethod::kGetAssetInfo, start, assetPath, resolvedPath.GetPathString(),
+          result.assetName);
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_GetAssetInfo")
+      .field("assetPath", assetPath)
+      .field("resolvedPath", resolvedPath.GetPathString())
+      .field("result(assetName)", result.assetName)
+      .field("result(repoPath)", result.repoPath);
   return result;
 }
 
 ArTimestamp UsdOpenAssetIOResolver::_GetModificationTimestamp(
     const std::string &assetPath, const ArResolvedPath &resolvedPath) const {
-  auto result = ArDefaultResolver::_GetModificationTimestamp(assetPath, resolvedPath);
-  TF_DEBUG(OPENASSETIO_RESOLVER)
-      .Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() + "\n  assetPath: " + assetPath +
-           "\n  resolvedPath :" + resolvedPath.GetPathString() +
-           "\n  result: " + std::to_string(result.GetTime()) + "\n");
+  TRACE_FUNCTION();
+  const auto start = startCall();
+  ArTimestamp result;
+  // Only if configured to assume entity references resolve to
+  // published, so unchanging, files. Otherwise, layers edited in place
+  // would never be reloaded.
+  const bool cacheable = timestampCache_ && entityReferenceMatcher_.isEntityReference(assetPath);
+  CachedTimestamp cached;
+  if (cacheable && timestampCache_->find(assetPath, 0, cached) &&
+      cached.resolvedPath == resolvedPath) {
+    result = cached.timestamp;
+  } else {
+    {
+      TRACE_SCOPE("ArDefaultResolver::_GetModificationTimestamp");
+      result = ArDefaultResolver::_GetModificationTimestamp(assetPath, resolvedPath);
+    }
+    if (cacheable) {
+      timestampCache_->insert(assetPath, 0, CachedTimestamp{resolvedPath, result});
+    }
+  }
+  endCall(ResolverMethod::kGetModificationTimestamp, start, assetPath,
+          resolvedPath.GetPathString(),
+          callTraceWriter_ ? std::to_string(result.GetTime()) : std::string{});
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_GetModificationTimestamp")
+      .field("assetPath", assetPath)
+      .field("resolvedPath", resolvedPath.GetPathString())
+      .field("result", result.GetTime());
   return result;
 }
 
 std::shared_ptr<ArAsset> UsdOpenAssetIOResolver::_OpenAsset(
     const ArResolvedPath &resolvedPath) const {
-  TF_DEBUG(OPENASSETIO_RESOLVER)
-      .Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() +
-           "\n  resolvedPath :" + resolvedPath.GetPathString() + "\n");
-  return ArDefaultResolver::_OpenAsset(resolvedPath);
+  TRACE_FUNCTION();
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_OpenAsset")
+      .field("resolvedPath", resolvedPath.GetPathString());
+  const auto start = startCall();
+  std::shared_ptr<ArAsset> result;
+  if (shareAssets_) {
+    initDeferredState();
+  }
+  // Assets within packages (e.g. usdz) are not files, so are never
+  // cached.
+  AssetBufferCache::FileStamp stamp;
+  const bool stamped = (assetBufferCache_ || shareAssets_) &&
+                       AssetBufferCache::FileStamp::of(resolvedPath.GetPathString(), stamp);
+  const bool cacheable = stamped && assetBufferCache_ && assetBufferCache_->admits(stamp.size);
+  const bool shareable = stamped && shareAssets_ && sharedCache_;
+  AssetBufferCache::Buffer buffer;
+  if (cacheable && assetBufferCache_->find(resolvedPath.GetPathString(), stamp, buffer)) {
+    TRACE_COUNTER_DELTA("OpenAssetIO asset buffer cache hits", 1);
+  } else if (shareable && sharedCache_->findAsset(resolvedPath.GetPathString(), stamp, buffer)) {
+    TRACE_COUNTER_DELTA("OpenAssetIO shared cache asset hits", 1);
+  } else {
+    result = openFileAsset(resolvedPath);
+    // Read in full now, so later opens share the buffer.
+    if (result && (cacheable || shareable)) {
+      TRACE_SCOPE("ArAsset::GetBuffer");
+      buffer = AssetBufferCache::Buffer{result->GetBuffer(), result->GetSize()};
+      if (buffer.data && cacheable) {
+        assetBufferCache_->insert(resolvedPath.GetPathString(), stamp, buffer);
+      }
+      if (buffer.data && shareable) {
+        sharedCache_->publishAsset(resolvedPath.GetPathString(), stamp,
+                                   std::string_view{buffer.data.get(), buffer.size});
+      }
+    }
+  }
+  if (buffer.data) {
+    result = ArInMemoryAsset::FromBuffer(buffer.data, buffer.size);
+  }
+  // Prefetching is only worthwhile if there is a cache scope to hold
+  // the results until composition asks for them.
+  if (const CachePtr cache = threadCache_.GetCurrentCache(); result && cache) {
+    result = prefetchLayerEntityReferences(*cache, std::move(result));
+  }
+  endCall(ResolverMethod::kOpenAsset, start, resolvedPath.GetPathString(), {},
+          callTraceWriter_ && result ? std::to_string(result->GetSize()) : std::string{});
+  return result;
 }
 
 bool UsdOpenAssetIOResolver::_CanWriteAssetToPath(const ArResolvedPath &resolvedPath,
                                                   std::string *whyNot) const {
-  auto result = ArDefaultResolver::CanWriteAssetToPath(resolvedPath, whyNot);
-  TF_DEBUG(OPENASSETIO_RESOLVER)
-      .Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() +
-           "\n  resolvedPath :" + resolvedPath.GetPathString() +
-           "\n  result: " + std::to_string(static_cast<int>(result)) + "\n");
+  TRACE_FUNCTION();
+  const auto start = startCall();
+  bool result;
+  {
+    TRACE_SCOPE("ArDefaultResolver::_CanWriteAssetToPath");
+    result = ArDefaultResolver::_CanWriteAssetToPath(resolvedPath, whyNot);
+  }
+  endCall(ResolverMethod::kCanWriteAssetToPath, start, resolvedPath.GetPathString(), {},
+          result ? "1" : "0");
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_CanWriteAssetToPath")
+      .field("resolvedPath", resolvedPath.GetPathString())
+      .field("result", std::int64_t{result});
   return result;
 }
 
 std::shared_ptr<ArWritableAsset> UsdOpenAssetIOResolver::_OpenAssetForWrite(
     const ArResolvedPath &resolvedPath, WriteMode writeMode) const {
-  TF_DEBUG(OPENASSETIO_RESOLVER)
-      .Msg("OPENASSETIO_RESOLVER: " + TF_FUNC_NAME() +
-           "\n  resolvedPath :" + resolvedPath.GetPathString() + "\n");
-  return ArDefaultResolver::_OpenAssetForWrite(resolvedPath, writeMode);
+  TRACE_FUNCTION();
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_OpenAssetForWrite")
+      .field("resolvedPath", resolvedPath.GetPathString());
+  const auto start = startCall();
+  std::shared_ptr<ArWritableAsset> result;
+  {
+    TRACE_SCOPE("ArDefaultResolver::_OpenAssetForWrite");
+    result = ArDefaultResolver::_OpenAssetForWrite(resolvedPath, writeMode);
+  }
+  // File paths are their own identifiers once anchored, so a written
+  // file is no longer missing, by that path at least.
+  if (unresolvedPathCache_ && result) {
+    unresolvedPathCache_->erase(resolvedPath.GetPathString(), currentContextHash());
+  }
+  endCall(ResolverMethod::kOpenAssetForWrite, start, resolvedPath.GetPathString(),
+          writeMode == WriteMode::Update ? "update" : "replace", result ? "1" : "0");
+  return result;
+}
+
+/* Scoped Caches */
+void UsdOpenAssetIOResolver::_BeginCacheScope(VtValue *cacheScopeData) {
+  TRACE_FUNCTION();
+  endCall(ResolverMethod::kBeginCacheScope, startCall(), {}, {}, {});
+  threadCache_.BeginCacheScope(cacheScopeData);
+  const CachePtr cache = threadCache_.GetCurrentCache();
+  if (!TF_VERIFY(cache)) {
+    return;
+  }
+  // Work on a copy, since the cache may be shared with other threads
+  // that are entering the same scope. The copy is only written back
+  // the first time, whilst the cache is still private to this thread.
+  VtValue defaultResolverScopeData = cache->defaultResolverScopeData;
+  ArDefaultResolver::_BeginCacheScope(&defaultResolverScopeData);
+  if (cache->defaultResolverScopeData.IsEmpty()) {
+    cache->defaultResolverScopeData = defaultResolverScopeData;
+  }
+}
+
+void UsdOpenAssetIOResolver::_EndCacheScope(VtValue *cacheScopeData) {
+  TRACE_FUNCTION();
+  if (const CachePtr cache = threadCache_.GetCurrentCache()) {
+    VtValue defaultResolverScopeData = cache->defaultResolverScopeData;
+    ArDefaultResolver::_EndCacheScope(&defaultResolverScopeData);
+  }
+  threadCache_.EndCacheScope(cacheScopeData);
+  ThreadResolveCache::invalidateAll();
+  endCall(ResolverMethod::kEndCacheScope, startCall(), {}, {}, {});
+}
+
+/* Context Operations */
+// Contexts are tracked by Ar, so binds are only observed, so that call
+// traces replay in the same context.
+void UsdOpenAssetIOResolver::_BindContext(const ArResolverContext &context,
+                                          VtValue *bindingData) {
+  ArDefaultResolver::_BindContext(context, bindingData);
+  std::string searchPath;
+  if (const auto *defaultContext = context.Get<ArDefaultResolverContext>();
+      defaultContext && callTraceWriter_) {
+    searchPath = encodeSearchPath(defaultContext->GetSearchPath());
+  }
+  endCall(ResolverMethod::kBindContext, startCall(), searchPath, {}, {});
+}
+
+void UsdOpenAssetIOResolver::_UnbindContext(const ArResolverContext &context,
+                                            VtValue *bindingData) {
+  ArDefaultResolver::_UnbindContext(context, bindingData);
+  endCall(ResolverMethod::kUnbindContext, startCall(), {}, {}, {});
+}
+
+void UsdOpenAssetIOResolver::_RefreshContext(const ArResolverContext &context) {
+  TRACE_FUNCTION();
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::_RefreshContext");
+  // Entries cannot be found by context alone, so all are discarded.
+  if (resolvedPathCache_) {
+    resolvedPathCache_->clear();
+  }
+  if (assetInfoCache_) {
+    assetInfoCache_->clear();
+    timestampCache_->clear();
+  }
+  if (unresolvedPathCache_) {
+    unresolvedPathCache_->clear();
+  }
+  if (assetBufferCache_) {
+    assetBufferCache_->clear();
+  }
+  // Other processes sharing the cache re-query too, as they cannot
+  // tell which resolutions were made before the refresh. Deferred
+  // state not yet initialised holds nothing to forget, so is left so.
+  const bool deferredStateReady = deferredStateReady_.load(std::memory_order_acquire);
+  if (deferredStateReady && sharedCache_) {
+    sharedCache_->invalidateResolutions();
+  }
+  // Changes found against the entries just cleared no longer apply.
+  if (deferredStateReady && revalidator_) {
+    revalidator_->discard();
+  }
+  // Unlike cache entries, pins can be found by context. Loaded pins,
+  // which apply in every context, are kept.
+  if (versionPins_) {
+    versionPins_->unpin(contextHashOf(context));
+  }
+  ThreadResolveCache::invalidateAll();
+  ArDefaultResolver::_RefreshContext(context);
+}
+
+// ------------------------------------------------------------
+/* Instrumentation */
+CallClock::time_point UsdOpenAssetIOResolver::startCall() const noexcept {
+  return callStats_ || callTraceWriter_ ? CallClock::now() : CallClock::time_point{};
+}
+
+void UsdOpenAssetIOResolver::endCall(const ResolverMethod method,
+                                     const CallClock::time_point start,
+                                     const std::string_view arg0, const std::string_view arg1,
+                                     const std::string_view result) const {
+  if (!callStats_ && !callTraceWriter_) {
+    return;
+  }
+  const auto end = CallClock::now();
+  if (callStats_) {
+    callStats_->record(method, end - start);
+  }
+  if (callTraceWriter_) {
+    callTraceWriter_->write(method, start, end, arg0, arg1, result);
+  }
+}
+
+// ------------------------------------------------------------
+/* Entity Reference Resolution */
+ArResolvedPath UsdOpenAssetIOResolver::resolveFilePath(const std::string &assetPath) const {
+  if (!unresolvedPathCache_) {
+    TRACE_SCOPE("ArDefaultResolver::_Resolve");
+    return ArDefaultResolver::_Resolve(assetPath);
+  }
+  // Search path lookups depend on the context.
+  const std::size_t contextHash = currentContextHash();
+  if (unresolvedPathCache_->contains(assetPath, contextHash)) {
+    TRACE_COUNTER_DELTA("OpenAssetIO unresolved path cache hits", 1);
+    return {};
+  }
+  ArResolvedPath resolvedPath;
+  {
+    TRACE_SCOPE("ArDefaultResolver::_Resolve");
+    resolvedPath = ArDefaultResolver::_Resolve(assetPath);
+  }
+  if (resolvedPath.IsEmpty()) {
+    unresolvedPathCache_->insert(assetPath, contextHash);
+  }
+  return resolvedPath;
+}
+
+ArResolvedPath UsdOpenAssetIOResolver::resolveEntityReference(const std::string &assetPath) const {
+  TRACE_FUNCTION();
+  if (threadResolveCacheOwner_ == 0) {
+    return resolveEntityReferenceShared(assetPath);
+  }
+  // Read before resolving, so a result computed across an
+  // invalidation is stored as already stale.
+  const std::uint64_t generation = ThreadResolveCache::generation();
+  const std::size_t contextHash = currentContextHash();
+  const std::size_t hash = ResolveKey::hash(assetPath, contextHash);
+
+  ArResolvedPath resolvedPath;
+  if (ThreadResolveCache::forThread(threadResolveCacheOwner_)
+          .find(hash, generation, assetPath, contextHash, resolvedPath)) {
+    TRACE_COUNTER_DELTA("OpenAssetIO thread resolve cache hits", 1);
+    return resolvedPath;
+  }
+  resolvedPath = resolveEntityReferenceShared(assetPath);
+  if (!resolvedPath.IsEmpty()) {
+    ThreadResolveCache::forThread(threadResolveCacheOwner_)
+        .insert(hash, generation, assetPath, contextHash, resolvedPath);
+  }
+  return resolvedPath;
+}
+
+ArResolvedPath UsdOpenAssetIOResolver::resolveEntityReferenceShared(
+    const std::string &assetPath) const {
+  const CachePtr cache = threadCache_.GetCurrentCache();
+  if (!cache) {
+    return queryEntityReference(assetPath);
+  }
+  // Concurrent callers within the same scope wait on the accessor
+  // whilst the first resolves the entry.
+  Cache::EntityReferenceMap::accessor accessor;
+  if (cache->resolvedEntityReferences.insert(accessor, assetPath)) {
+    TRACE_COUNTER_DELTA("OpenAssetIO entity reference cache misses", 1);
+    accessor->second = queryEntityReference(assetPath);
+  } else {
+    TRACE_COUNTER_DELTA("OpenAssetIO entity reference cache hits", 1);
+  }
+  return accessor->second;
+}
+
+ArResolvedPath UsdOpenAssetIOResolver::queryEntityReference(const std::string &assetPath) const {
+  initDeferredState();
+  ArResolvedPath resolvedPath;
+  if (findInManifest(assetPath, resolvedPath)) {
+    return resolvedPath;
+  }
+  const std::size_t contextHash = currentContextHash();
+  if (findPinned(assetPath, contextHash, resolvedPath)) {
+    return resolvedPath;
+  }
+  if (resolvedPathCache_ && resolvedPathCache_->find(assetPath, contextHash, resolvedPath)) {
+    TRACE_COUNTER_DELTA("OpenAssetIO resolved path cache hits", 1);
+    return resolvedPath;
+  }
+  if (unresolvedPathCache_ && unresolvedPathCache_->contains(assetPath, contextHash)) {
+    TRACE_COUNTER_DELTA("OpenAssetIO unresolved path cache hits", 1);
+    return resolvedPath;
+  }
+  // Concurrent queries for the same reference, e.g. from parallel
+  // composition, are coalesced into one.
+  return entityReferenceQueries_.run(
+      ResolveKey{assetPath, contextHash}, [this, &assetPath, contextHash] {
+        // Another query may have completed since the lookup above.
+        ArResolvedPath result;
+        if (resolvedPathCache_ && resolvedPathCache_->find(assetPath, contextHash, result)) {
+          return result;
+        }
+        TRACE_COUNTER_DELTA("OpenAssetIO resolved path cache misses", 1);
+        if (!findShared(assetPath, contextHash, result)) {
+          std::vector<ArResolvedPath> results(1);
+          queryManager({assetPath}, {0}, results);
+          result = std::move(results[0]);
+          publishShared(assetPath, contextHash, result);
+        }
+        if (versionPins_ && !result.IsEmpty()) {
+          result = versionPins_->pin(assetPath, contextHash, result);
+        }
+        if (resolvedPathCache_ && !result.IsEmpty()) {
+          resolvedPathCache_->insert(assetPath, contextHash, result);
+          if (revalidator_) {
+            revalidator_->addContext(contextHash, GetCurrentContext());
+          }
+        }
+        if (unresolvedPathCache_ && result.IsEmpty()) {
+          unresolvedPathCache_->insert(assetPath, contextHash);
+        }
+        recordResolution(assetPath, result);
+        return result;
+      });
+}
+
+std::vector<ArResolvedPath> UsdOpenAssetIOResolver::resolveEntityReferences(
+    const std::vector<std::string> &assetPaths) const {
+  TRACE_FUNCTION();
+  initDeferredState();
+  const std::size_t contextHash = currentContextHash();
+  std::vector<ArResolvedPath> resolvedPaths(assetPaths.size());
+  std::vector<std::size_t> uncachedIndices;
+  for (std::size_t idx = 0; idx < assetPaths.size(); ++idx) {
+    if (findInManifest(assetPaths[idx], resolvedPaths[idx]) ||
+        findPinned(assetPaths[idx], contextHash, resolvedPaths[idx])) {
+      continue;
+    }
+    if (resolvedPathCache_ &&
+        resolvedPathCache_->find(assetPaths[idx], contextHash, resolvedPaths[idx])) {
+      continue;
+    }
+    if (!unresolvedPathCache_ || !unresolvedPathCache_->contains(assetPaths[idx], contextHash)) {
+      uncachedIndices.push_back(idx);
+    }
+  }
+  TRACE_COUNTER_DELTA("OpenAssetIO entity references batch resolved",
+                      static_cast<double>(uncachedIndices.size()));
+  std::vector<std::size_t> queryIndices;
+  for (const std::size_t idx : uncachedIndices) {
+    if (!findShared(assetPaths[idx], contextHash, resolvedPaths[idx])) {
+      queryIndices.push_back(idx);
+    }
+  }
+  queryManager(assetPaths, queryIndices, resolvedPaths);
+  for (const std::size_t idx : queryIndices) {
+    publishShared(assetPaths[idx], contextHash, resolvedPaths[idx]);
+  }
+  for (const std::size_t idx : uncachedIndices) {
+    if (versionPins_ && !resolvedPaths[idx].IsEmpty()) {
+      resolvedPaths[idx] = versionPins_->pin(assetPaths[idx], contextHash, resolvedPaths[idx]);
+    }
+    if (resolvedPathCache_ && !resolvedPaths[idx].IsEmpty()) {
+      resolvedPathCache_->insert(assetPaths[idx], contextHash, resolvedPaths[idx]);
+      if (revalidator_) {
+        revalidator_->addContext(contextHash, GetCurrentContext());
+      }
+    }
+    if (unresolvedPathCache_ && resolvedPaths[idx].IsEmpty()) {
+      unresolvedPathCache_->insert(assetPaths[idx], contextHash);
+    }
+    recordResolution(assetPaths[idx], resolvedPaths[idx]);
+  }
+  return resolvedPaths;
+}
+
+void UsdOpenAssetIOResolver::queryManager(const std::vector<std::string> &assetPaths,
+                                          const std::vector<std::size_t> &indices,
+                                          std::vector<ArResolvedPath> &resolvedPaths) const {
+  if (indices.empty()) {
+    return;
+  }
+  if (daemonClient_) {
+    static const std::vector<std::string> kNoSearchPath;
+    const auto *context = _GetCurrentContextObject<ArDefaultResolverContext>();
+    std::vector<std::string_view> batch;
+    batch.reserve(indices.size());
+    for (const std::size_t idx : indices) {
+      batch.emplace_back(assetPaths[idx]);
+    }
+    std::vector<std::string> daemonPaths;
+    bool resolved;
+    {
+      TRACE_SCOPE("ResolveDaemonClient::resolve");
+      resolved = daemonClient_->resolve(context ? context->GetSearchPath() : kNoSearchPath,
+                                        batch, daemonPaths);
+    }
+    if (resolved) {
+      for (std::size_t idx = 0; idx < indices.size(); ++idx) {
+        resolvedPaths[indices[idx]] = ArResolvedPath{std::move(daemonPaths[idx])};
+      }
+      return;
+    }
+    TRACE_COUNTER_DELTA("OpenAssetIO resolve daemon failures", 1);
+  }
+  // Until a manager is hosted, entity references are resolved by the
+  // default resolver, which is where the manager query will be made.
+  TRACE_SCOPE("ArDefaultResolver::_Resolve");
+  for (const std::size_t idx : indices) {
+    resolvedPaths[idx] = ArDefaultResolver::_Resolve(assetPaths[idx]);
+  }
+}
+
+bool UsdOpenAssetIOResolver::requeryEntityReference(const std::string &assetPath,
+                                                    const ArResolverContext &context,
+                                                    ArResolvedPath &resolvedPath) const {
+  TRACE_FUNCTION();
+  // Context objects are found through the bindings of the primary
+  // resolver, i.e. this one once dispatched to.
+  const ArResolverContextBinder binder{context};
+  std::vector<ArResolvedPath> results(1);
+  queryManager({assetPath}, {0}, results);
+  resolvedPath = std::move(results[0]);
+  return !resolvedPath.IsEmpty();
+}
+
+std::size_t UsdOpenAssetIOResolver::revalidate() {
+  TRACE_FUNCTION();
+  // Nothing has been resolved, so revalidated, before initialisation.
+  if (!deferredStateReady_.load(std::memory_order_acquire) || !revalidator_) {
+    return 0;
+  }
+  const std::vector<ResolutionRevalidator::Change> changes = revalidator_->apply();
+  if (changes.empty()) {
+    return 0;
+  }
+  ThreadResolveCache::invalidateAll();
+
+  std::vector<ArResolverContext> contexts;
+  for (const ResolutionRevalidator::Change &change : changes) {
+    OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::revalidate")
+        .field("assetPath", change.assetPath)
+        .field("resolvedPath", change.resolvedPath.GetPathString());
+    if (std::find(contexts.begin(), contexts.end(), change.context) == contexts.end()) {
+      contexts.push_back(change.context);
+    }
+  }
+  // The notice cannot be scoped to asset paths, so is scoped to the
+  // contexts the changed resolutions were made in.
+  for (const ArResolverContext &context : contexts) {
+    if (context.IsEmpty()) {
+      ArNotice::ResolverChanged{}.Send();
+    } else {
+      ArNotice::ResolverChanged{context}.Send();
+    }
+  }
+  return changes.size();
+}
+
+bool UsdOpenAssetIOResolver::findInManifest(const std::string &assetPath,
+                                            ArResolvedPath &resolvedPath) const {
+  std::string_view manifestPath;
+  if (!resolutionManifest_ || !resolutionManifest_->find(assetPath, manifestPath)) {
+    return false;
+  }
+  TRACE_COUNTER_DELTA("OpenAssetIO resolution manifest hits", 1);
+  resolvedPath = ArResolvedPath{std::string{manifestPath}};
+  // So that an exported manifest is complete even when one is in use.
+  recordResolution(assetPath, resolvedPath);
+  return true;
+}
+
+bool UsdOpenAssetIOResolver::findPinned(const std::string &assetPath,
+                                        const std::size_t contextHash,
+                                        ArResolvedPath &resolvedPath) const {
+  if (!versionPins_ || !versionPins_->find(assetPath, contextHash, resolvedPath)) {
+    return false;
+  }
+  TRACE_COUNTER_DELTA("OpenAssetIO version pin hits", 1);
+  recordResolution(assetPath, resolvedPath);
+  return true;
+}
+
+bool UsdOpenAssetIOResolver::findShared(const std::string &assetPath,
+                                        const std::size_t contextHash,
+                                        ArResolvedPath &resolvedPath) const {
+  std::string_view sharedPath;
+  if (!sharedCache_ || !sharedCache_->findResolution(assetPath, contextHash, sharedPath)) {
+    return false;
+  }
+  TRACE_COUNTER_DELTA("OpenAssetIO shared cache hits", 1);
+  resolvedPath = ArResolvedPath{std::string{sharedPath}};
+  return true;
+}
+
+void UsdOpenAssetIOResolver::publishShared(const std::string &assetPath,
+                                           const std::size_t contextHash,
+                                           const ArResolvedPath &resolvedPath) const {
+  if (sharedCache_ && !resolvedPath.IsEmpty()) {
+    sharedCache_->publishResolution(assetPath, contextHash, resolvedPath.GetPathString());
+  }
+}
+
+void UsdOpenAssetIOResolver::recordResolution(const std::string &assetPath,
+                                              const ArResolvedPath &resolvedPath) const {
+  if (resolutionRecorder_ && !resolvedPath.IsEmpty()) {
+    resolutionRecorder_->record(assetPath, resolvedPath.GetPathString());
+  }
+}
+
+std::size_t UsdOpenAssetIOResolver::currentContextHash() const {
+  const auto *context = _GetCurrentContextObject<ArDefaultResolverContext>();
+  return context ? hash_value(*context) : 0;
+}
+
+std::shared_ptr<ArAsset> UsdOpenAssetIOResolver::openFileAsset(
+    const ArResolvedPath &resolvedPath) const {
+  // The original is opened if the local copy is not yet made, or has
+  // since been evicted by another process.
+  if (assetLocalizer_) {
+    if (const ArResolvedPath localPath = localCopyOf(resolvedPath); !localPath.IsEmpty()) {
+      if (std::shared_ptr<ArAsset> asset = openFileAsset(localPath)) {
+        TRACE_COUNTER_DELTA("OpenAssetIO localized asset opens", 1);
+        return asset;
+      }
+    }
+  }
+  // Assets within packages (e.g. usdz) are left to the default
+  // resolver, as is any file that cannot be mapped.
+  if (mappedAssetOptions_ && !ArIsPackageRelativePath(resolvedPath.GetPathString())) {
+    TRACE_SCOPE("MappedFileAsset::open");
+    if (std::shared_ptr<ArAsset> asset =
+            MappedFileAsset::open(resolvedPath.GetPathString(), *mappedAssetOptions_)) {
+      return asset;
+    }
+  }
+  TRACE_SCOPE("ArDefaultResolver::_OpenAsset");
+  return ArDefaultResolver::_OpenAsset(resolvedPath);
+}
+
+ArResolvedPath UsdOpenAssetIOResolver::localCopyOf(const ArResolvedPath &resolvedPath) const {
+  const std::string filePath = packageOrFilePath(resolvedPath.GetPathString());
+  std::string localPath;
+  if (!assetLocalizer_->handles(filePath)) {
+    return {};
+  }
+  {
+    TRACE_SCOPE("AssetLocalizer::find");
+    if (!assetLocalizer_->find(filePath, localPath)) {
+      return {};
+    }
+  }
+  if (filePath.size() == resolvedPath.GetPathString().size()) {
+    return ArResolvedPath{std::move(localPath)};
+  }
+  return ArResolvedPath{ArJoinPackageRelativePath(
+      localPath, ArSplitPackageRelativePathOuter(resolvedPath.GetPathString()).second)};
+}
+
+std::shared_ptr<ArAsset> UsdOpenAssetIOResolver::prefetchLayerEntityReferences(
+    Cache &cache, std::shared_ptr<ArAsset> asset) const {
+  TRACE_FUNCTION();
+  if (!isTextLayer(*asset)) {
+    return asset;
+  }
+  // The layer contents are read once here, and handed on as an
+  // in-memory asset so the file format does not read them again.
+  std::shared_ptr<const char> buffer;
+  {
+    TRACE_SCOPE("ArAsset::GetBuffer");
+    buffer = asset->GetBuffer();
+  }
+  if (!buffer) {
+    return asset;
+  }
+  const std::size_t size = asset->GetSize();
+  TRACE_COUNTER_DELTA("OpenAssetIO layer bytes scanned", static_cast<double>(size));
+  std::vector<std::string> assetPaths;
+  {
+    TRACE_SCOPE("Scan layer for entity references");
+    assetPaths = findEntityReferences({buffer.get(), size}, entityReferenceMatcher_);
+  }
+  prefetchEntityReferences(cache, std::move(assetPaths));
+  return ArInMemoryAsset::FromBuffer(buffer, size);
+}
+
+void UsdOpenAssetIOResolver::prefetchEntityReferences(Cache &cache,
+                                                      std::vector<std::string> assetPaths) const {
+  TRACE_FUNCTION();
+  assetPaths.erase(std::remove_if(assetPaths.begin(), assetPaths.end(),
+                                  [&cache](const std::string &assetPath) {
+                                    Cache::EntityReferenceMap::const_accessor accessor;
+                                    return cache.resolvedEntityReferences.find(accessor,
+                                                                               assetPath);
+                                  }),
+                   assetPaths.end());
+  if (assetPaths.empty()) {
+    return;
+  }
+  OPENASSETIO_RESOLVER_LOG("UsdOpenAssetIOResolver::prefetchEntityReferences")
+      .field("count", static_cast<std::int64_t>(assetPaths.size()));
+
+  auto resolvedPaths = resolveEntityReferences(assetPaths);
+  for (std::size_t idx = 0; idx < assetPaths.size(); ++idx) {
+    // Entries inserted concurrently by other threads are left as-is.
+    cache.resolvedEntityReferences.insert(
+        {std::move(assetPaths[idx]), std::move(resolvedPaths[idx])});
+  }
+}
+
+// ------------------------------------------------------------
+/* C Entry Points */
+std::size_t UsdOpenAssetIOResolverRevalidate() {
+  auto *resolver = dynamic_cast<UsdOpenAssetIOResolver *>(&ArGetUnderlyingResolver());
+  return resolver ? resolver->revalidate() : 0;
 }
@@ -2,16 +2,57 @@
 // Copyright 2023 The Foundry Visionmongers Ltd
 #pragma once
 
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include <pxr/base/vt/value.h>
 #include <pxr/usd/ar/defaultResolver.h>
+#include <pxr/usd/ar/threadLocalScopedCache.h>
+#include <tbb/concurrent_hash_map.h>
+
+#include "assetBufferCache.h"
+#include "assetLocalizer.h"
+#include "assetMetadataCache.h"
+#include "cacheStats.h"
+#include "callStats.h"
+#include "callTrace.h"
+#include "entityReferenceMatcher.h"
+#include "mappedFileAsset.h"
+#include "resolutionManifest.h"
+#include "resolutionRevalidator.h"
+#include "resolveDaemonClient.h"
+#include "resolvedPathCache.h"
+#include "resolverMethod.h"
+#include "sharedResolutionCache.h"
+#include "singleFlight.h"
+#include "threadResolveCache.h"
+#include "unresolvedPathCache.h"
+#include "versionPins.h"
 
 class UsdOpenAssetIOResolver final : public PXR_NS::ArDefaultResolver {
  public:
   UsdOpenAssetIOResolver();
   ~UsdOpenAssetIOResolver() override;
 
+  /// Apply the changes to cached entity reference resolutions found by
+  /// background revalidation, if enabled, sending
+  /// ArNotice::ResolverChanged for them on the calling thread, e.g. an
+  /// application's idle loop. Returns the number of changes applied.
+  std::size_t revalidate();
+
+  /// The classification of asset paths as entity references, as
+  /// configured by OPENASSETIO_RESOLVER_ENTITY_REFERENCE_PREFIX.
+  [[nodiscard]] const EntityReferenceMatcher &entityReferenceMatcher() const noexcept {
+    return entityReferenceMatcher_;
+  }
+
  protected:
   /* Ar Resolver Implementation */
   [[nodiscard]] std::string _CreateIdentifier(
@@ -43,5 +84,167 @@ class UsdOpenAssetIOResolver final : public PXR_NS::ArDefaultResolver {
   [[nodiscard]] std::shared_ptr<PXR_NS::ArWritableAsset> _OpenAssetForWrite(
       const PXR_NS::ArResolvedPath &resolvedPath, WriteMode writeMode) const final;
 
+  /* Scoped Caches */
+  void _BeginCacheScope(PXR_NS::VtValue *cacheScopeData) final;
+
+  void _EndCacheScope(PXR_NS::VtValue *cacheScopeData) final;
+
+  /* Context Operations */
+  void _BindContext(const PXR_NS::ArResolverContext &context,
+                    PXR_NS::VtValue *bindingData) final;
+
+  void _UnbindContext(const PXR_NS::ArResolverContext &context,
+                      PXR_NS::VtValue *bindingData) final;
+
+  void _RefreshContext(const PXR_NS::ArResolverContext &context) final;
+
  private:
+  struct Cache;
+
+  // Open the manifest, load pinned versions, open the shared cache and
+  // start revalidation, as configured, the first time it is called,
+  // so that processes that never resolve an entity reference pay
+  // nothing for them.
+  void initDeferredState() const;
+
+  // Start timing a call, if instrumentation is enabled.
+  [[nodiscard]] CallClock::time_point startCall() const noexcept;
+
+  // Record a completed call to the call stats and/or call trace.
+  void endCall(ResolverMethod method, CallClock::time_point start, std::string_view arg0,
+               std::string_view arg1, std::string_view result) const;
+
+  [[nodiscard]] PXR_NS::ArResolvedPath resolveEntityReference(const std::string &assetPath) const;
+
+  // Resolve an entity reference through the caches shared between
+  // threads, i.e. skipping this thread's cache.
+  [[nodiscard]] PXR_NS::ArResolvedPath resolveEntityReferenceShared(
+      const std::string &assetPath) const;
+
+  // Resolve a plain asset path through the default resolver,
+  // consulting the unresolved path cache, if enabled.
+  [[nodiscard]] PXR_NS::ArResolvedPath resolveFilePath(const std::string &assetPath) const;
+
+  // Query the resolution of a single entity reference, bypassing any
+  // cache scope, but consulting the process-wide cache.
+  [[nodiscard]] PXR_NS::ArResolvedPath queryEntityReference(const std::string &assetPath) const;
+
+  [[nodiscard]] std::vector<PXR_NS::ArResolvedPath> resolveEntityReferences(
+      const std::vector<std::string> &assetPaths) const;
+
+  // Resolve a cached entity reference again, in the given context,
+  // for revalidation.
+  bool requeryEntityReference(const std::string &assetPath,
+                              const PXR_NS::ArResolverContext &context,
+                              PXR_NS::ArResolvedPath &resolvedPath) const;
+
+  // Look up an entity reference in the resolution manifest, if any.
+  bool findInManifest(const std::string &assetPath, PXR_NS::ArResolvedPath &resolvedPath) const;
+
+  // Look up the version pinned for an entity reference, if pinning.
+  bool findPinned(const std::string &assetPath, std::size_t contextHash,
+                  PXR_NS::ArResolvedPath &resolvedPath) const;
+
+  // Resolve the asset paths at the given indices with the manager,
+  // through the resolve daemon if configured and reachable, else in
+  // process, setting the resolved paths at the same indices.
+  void queryManager(const std::vector<std::string> &assetPaths,
+                    const std::vector<std::size_t> &indices,
+                    std::vector<PXR_NS::ArResolvedPath> &resolvedPaths) const;
+
+  // Look up a resolution published by any process sharing the cache,
+  // if enabled.
+  bool findShared(const std::string &assetPath, std::size_t contextHash,
+                  PXR_NS::ArResolvedPath &resolvedPath) const;
+
+  // Publish a resolution for other processes sharing the cache, if
+  // enabled.
+  void publishShared(const std::string &assetPath, std::size_t contextHash,
+                     const PXR_NS::ArResolvedPath &resolvedPath) const;
+
+  // Record a resolution for export as a manifest, if enabled.
+  void recordResolution(const std::string &assetPath,
+                        const PXR_NS::ArResolvedPath &resolvedPath) const;
+
+  // Hash of the current ArDefaultResolverContext, or 0 if none, for
+  // keying caches that outlive a context binding.
+  [[nodiscard]] std::size_t currentContextHash() const;
+
+  // Open a file, from its local copy if localized, memory-mapped if
+  // enabled, or as ArDefaultResolver would.
+  [[nodiscard]] std::shared_ptr<PXR_NS::ArAsset> openFileAsset(
+      const PXR_NS::ArResolvedPath &resolvedPath) const;
+
+  // The path of the local copy of a file on a slow mount, or an empty
+  // path if it has not been copied yet.
+  [[nodiscard]] PXR_NS::ArResolvedPath localCopyOf(
+      const PXR_NS::ArResolvedPath &resolvedPath) const;
+
+  // Prefetch the entity references found in a text layer, returning
+  // the asset that should be used to read the layer.
+  [[nodiscard]] std::shared_ptr<PXR_NS::ArAsset> prefetchLayerEntityReferences(
+      Cache &cache, std::shared_ptr<PXR_NS::ArAsset> asset) const;
+
+  // Resolve any of the given entity references not already in the
+  // cache with a single batched query, and add them to the cache.
+  void prefetchEntityReferences(Cache &cache, std::vector<std::string> assetPaths) const;
+
+  // Resolutions remembered for the lifetime of a cache scope, e.g.
+  // the duration of a stage open. Mirrors ArDefaultResolver's
+  // search-path cache, whose scope data we carry alongside our own
+  // so that a single ArResolverScopedCache drives both.
+  struct Cache {
+    using EntityReferenceMap = tbb::concurrent_hash_map<std::string, PXR_NS::ArResolvedPath>;
+    EntityReferenceMap resolvedEntityReferences;
+    PXR_NS::VtValue defaultResolverScopeData;
+  };
+  using PerThreadCache = PXR_NS::ArThreadLocalScopedCache<Cache>;
+  using CachePtr = PerThreadCache::CachePtr;
+
+  const EntityReferenceMatcher entityReferenceMatcher_;
+  std::unique_ptr<CallTraceWriter> callTraceWriter_;
+  CallStats *callStats_{nullptr};
+  mutable PerThreadCache threadCache_;
+  // Guards the members set by initDeferredState, which are mutable
+  // only so that it can set them.
+  mutable std::once_flag deferredStateInit_;
+  // Set once those members are, for callers that only need them if
+  // already initialised.
+  mutable std::atomic<bool> deferredStateReady_{false};
+  mutable std::unique_ptr<ResolutionManifest> resolutionManifest_;
+  ResolutionRecorder *resolutionRecorder_{nullptr};
+  VersionPins *versionPins_{nullptr};
+  std::unique_ptr<ResolvedPathCache> resolvedPathCache_;
+  // Of entity references, so only present, if enabled, with
+  // resolvedPathCache_.
+  std::unique_ptr<AssetInfoCache> assetInfoCache_;
+  std::unique_ptr<TimestampCache> timestampCache_;
+  mutable std::vector<std::uint64_t> cacheStatsIds_;
+  std::unique_ptr<UnresolvedPathCache> unresolvedPathCache_;
+  // Present if file assets are to be memory-mapped.
+  std::optional<MappedFileAsset::Options> mappedAssetOptions_;
+  std::unique_ptr<AssetBufferCache> assetBufferCache_;
+  mutable std::unique_ptr<SharedResolutionCache> sharedCache_;
+  // Whether configured to share assets, whether or not the shared
+  // cache could be opened.
+  bool shareAssets_{false};
+  std::unique_ptr<ResolveDaemonClient> daemonClient_;
+  std::unique_ptr<AssetLocalizer> assetLocalizer_;
+  // Owner of this resolver's entries in ThreadResolveCache, or 0 if
+  // the per-thread cache is disabled.
+  std::uint64_t threadResolveCacheOwner_{0};
+  mutable SingleFlight<ResolveKey, PXR_NS::ArResolvedPath, ResolveKey::Hash>
+      entityReferenceQueries_;
+  // Declared last, so its thread is stopped before the members it
+  // uses are destroyed.
+  mutable std::unique_ptr<ResolutionRevalidator> revalidator_;
 };
+
+/**
+ * C entry point for applying revalidated resolutions from Python via
+ * ctypes, as UsdOpenAssetIOResolver::revalidate on the primary
+ * resolver. See CallStats.
+ */
+extern "C" {
+std::size_t UsdOpenAssetIOResolverRevalidate();
+}
@@ -0,0 +1,38 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "resolverMethod.h"
+
+const char *resolverMethodName(const ResolverMethod method) {
+  switch (method) {
+    case ResolverMethod::kCreateIdentifier:
+      return "_CreateIdentifier";
+    case ResolverMethod::kResolve:
+      return "_Resolve";
+    case ResolverMethod::kGetExtension:
+      return "_GetExtension";
+    case ResolverMethod::kGetAssetInfo:
+      return "_GetAssetInfo";
+    case ResolverMethod::kOpenAsset:
+      return "_OpenAsset";
+    case ResolverMethod::kGetModificationTimestamp:
+      return "_GetModificationTimestamp";
+    case ResolverMethod::kBeginCacheScope:
+      return "_BeginCacheScope";
+    case ResolverMethod::kEndCacheScope:
+      return "_EndCacheScope";
+    case ResolverMethod::kCreateIdentifierForNewAsset:
+      return "_CreateIdentifierForNewAsset";
+    case ResolverMethod::kResolveForNewAsset:
+      return "_ResolveForNewAsset";
+    case ResolverMethod::kCanWriteAssetToPath:
+      return "_CanWriteAssetToPath";
+    case ResolverMethod::kOpenAssetForWrite:
+      return "_OpenAssetForWrite";
+    case ResolverMethod::kBindContext:
+      return "_BindContext";
+    case ResolverMethod::kUnbindContext:
+      return "_UnbindContext";
+  }
+  return "<unknown>";
+}
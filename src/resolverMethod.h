@@ -0,0 +1,39 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Resolver entry points, as recorded by call traces and call stats.
+ *
+ * Values are persisted in trace files, so must not be changed. New
+ * methods must be added at the end.
+ */
+enum class ResolverMethod : std::uint8_t {
+  kCreateIdentifier = 0,
+  kResolve = 1,
+  kGetExtension = 2,
+  kGetAssetInfo = 3,
+  kOpenAsset = 4,
+  kGetModificationTimestamp = 5,
+  kBeginCacheScope = 6,
+  kEndCacheScope = 7,
+  kCreateIdentifierForNewAsset = 8,
+  kResolveForNewAsset = 9,
+  kCanWriteAssetToPath = 10,
+  kOpenAssetForWrite = 11,
+  kBindContext = 12,
+  kUnbindContext = 13,
+};
+
+constexpr std::size_t kResolverMethodCount =
+    static_cast<std::size_t>(ResolverMethod::kUnbindContext) + 1;
+
+/// Name of a resolver method, for reporting.
+const char *resolverMethodName(ResolverMethod method);
+
+/// Clock used to time resolver calls.
+using CallClock = std::chrono::steady_clock;
@@ -0,0 +1,365 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "sharedResolutionCache.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "pxr/base/tf/diagnostic.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free,
+              "Shared memory requires address-free atomics");
+
+struct SharedResolutionCache::Header {
+  // Set last by the creating process, once the rest is initialised.
+  std::atomic<std::uint64_t> magic;
+  std::uint64_t slotCount;
+  std::uint64_t slotsOffset;
+  std::uint64_t arenaOffset;
+  std::uint64_t arenaSize;
+  std::atomic<std::uint64_t> arenaUsed;
+  // Slots claimed, to bound the index's load.
+  std::atomic<std::uint64_t> slotsClaimed;
+  // Qualifies resolutions, so that bumping it invalidates them all.
+  std::atomic<std::uint64_t> generation;
+};
+
+struct SharedResolutionCache::Slot {
+  // Zero if empty.
+  std::atomic<std::uint64_t> hash;
+  // Offset of the record in the arena, once published.
+  std::atomic<std::uint64_t> offset;
+};
+
+// Followed by the key, then the value.
+struct SharedResolutionCache::Record {
+  Kind kind;
+  std::uint32_t keySize;
+  std::uint64_t valueSize;
+  Qualifier qualifier;
+};
+
+struct SharedResolutionCache::Mapping {
+  Mapping(void *mappedData, const std::size_t mappedSize) : data{mappedData}, size{mappedSize} {}
+
+  ~Mapping() { ::munmap(data, size); }
+
+  Mapping(const Mapping &) = delete;
+  Mapping &operator=(const Mapping &) = delete;
+
+  void *data;
+  std::size_t size;
+};
+
+namespace {
+constexpr std::uint64_t kMagic = 0x324843524f49414fULL;  // "OAIORCH2"
+constexpr std::size_t kMinSize = std::size_t{1} << 20U;
+// Proportion of the segment given to the index.
+constexpr std::size_t kIndexFraction = 8;
+constexpr std::size_t kAlignment = 64;
+// Slot offsets below this are not records: 0 marks a slot being
+// written, and 1 a slot abandoned as the arena was full.
+constexpr std::uint64_t kFirstRecordOffset = 8;
+constexpr std::uint64_t kAbandoned = 1;
+// How long to wait for another process to initialise the segment.
+constexpr auto kInitTimeout = std::chrono::seconds{2};
+
+constexpr std::size_t alignUp(const std::size_t value, const std::size_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+std::string segmentName(const std::string &name) {
+  return name.empty() || name.front() != '/' ? "/" + name : name;
+}
+
+// splitmix64 finaliser.
+std::uint64_t mix(std::uint64_t value) noexcept {
+  value ^= value >> 30U;
+  value *= 0xbf58476d1ce4e5b9ULL;
+  value ^= value >> 27U;
+  value *= 0x94d049bb133111ebULL;
+  value ^= value >> 31U;
+  return value;
+}
+
+// FNV-1a, which, unlike std::hash, is the same in every process.
+std::uint64_t fnv1a(const std::string_view str) noexcept {
+  std::uint64_t hash = 0xcbf29ce484222325ULL;
+  for (const char chr : str) {
+    hash ^= static_cast<unsigned char>(chr);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+}  // namespace
+
+std::unique_ptr<SharedResolutionCache> SharedResolutionCache::open(const std::string &name,
+                                                                   const std::size_t sizeBytes) {
+  const std::string shmName = segmentName(name);
+  bool created = true;
+  // NOLINTNEXTLINE(*-vararg)
+  int fd = ::shm_open(shmName.c_str(), O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+  if (fd < 0 && errno == EEXIST) {
+    created = false;
+    fd = ::shm_open(shmName.c_str(), O_RDWR | O_CLOEXEC, 0);  // NOLINT(*-vararg)
+  }
+  if (fd < 0) {
+    TF_WARN("Failed to open shared resolution cache '%s': %s", shmName.c_str(),
+            std::strerror(errno));
+    return nullptr;
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + kInitTimeout;
+  std::size_t size = std::max(sizeBytes, kMinSize);
+  if (created) {
+    if (::ftruncate(fd, static_cast<off_t>(size)) != 0) {
+      TF_WARN("Failed to size shared resolution cache '%s': %s", shmName.c_str(),
+              std::strerror(errno));
+      ::close(fd);
+      ::shm_unlink(shmName.c_str());
+      return nullptr;
+    }
+  } else {
+    // The creator may not have sized it yet.
+    struct stat info {};
+    while (::fstat(fd, &info) == 0 && static_cast<std::size_t>(info.st_size) < kMinSize &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    size = static_cast<std::size_t>(info.st_size);
+  }
+  void *data = size < kMinSize ? MAP_FAILED  // NOLINT(*-cstyle-cast, performance-no-int-to-ptr)
+                               : ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {  // NOLINT(*-cstyle-cast, performance-no-int-to-ptr)
+    TF_WARN("Failed to map shared resolution cache '%s'", shmName.c_str());
+    return nullptr;
+  }
+  auto mapping = std::make_shared<Mapping>(data, size);
+  auto *header = static_cast<Header *>(data);
+
+  if (created) {
+    // Freshly truncated memory is zeroed, so the index starts empty.
+    header->slotCount = kAlignment;
+    while (header->slotCount * 2 * sizeof(Slot) <= size / kIndexFraction) {
+      header->slotCount *= 2;
+    }
+    header->slotsOffset = alignUp(sizeof(Header), kAlignment);
+    header->arenaOffset = header->slotsOffset + header->slotCount * sizeof(Slot);
+    header->arenaSize = size - header->arenaOffset;
+    header->arenaUsed.store(kFirstRecordOffset, std::memory_order_relaxed);
+    header->magic.store(kMagic, std::memory_order_release);
+  } else {
+    while (header->magic.load(std::memory_order_acquire) != kMagic &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+    if (header->magic.load(std::memory_order_acquire) != kMagic ||
+        header->arenaOffset > size || header->arenaSize > size - header->arenaOffset ||
+        header->slotCount == 0 || (header->slotCount & (header->slotCount - 1)) != 0 ||
+        header->slotsOffset + header->slotCount * sizeof(Slot) > header->arenaOffset) {
+      TF_WARN("'%s' is not a shared resolution cache", shmName.c_str());
+      return nullptr;
+    }
+  }
+  // Private constructor, so make_unique is not available.
+  return std::unique_ptr<SharedResolutionCache>{
+      new SharedResolutionCache(std::move(mapping))};  // NOLINT(cppcoreguidelines-owning-memory)
+}
+
+bool SharedResolutionCache::unlink(const std::string &name) {
+  return ::shm_unlink(segmentName(name).c_str()) == 0;
+}
+
+SharedResolutionCache::SharedResolutionCache(std::shared_ptr<Mapping> mapping)
+    : mapping_{std::move(mapping)},
+      header_{static_cast<Header *>(mapping_->data)},
+      slots_{reinterpret_cast<Slot *>(static_cast<char *>(mapping_->data) +
+                                      header_->slotsOffset)},
+      arena_{static_cast<char *>(mapping_->data) + header_->arenaOffset} {}
+
+SharedResolutionCache::~SharedResolutionCache() = default;
+
+bool SharedResolutionCache::findResolution(const std::string_view assetPath,
+                                           const std::size_t contextHash,
+                                           std::string_view &resolvedPath) const noexcept {
+  const Record *record =
+      find(Kind::kResolution, assetPath,
+           Qualifier{contextHash, header_->generation.load(std::memory_order_acquire), 0});
+  if (!record) {
+    return false;
+  }
+  const char *value = reinterpret_cast<const char *>(record + 1) + record->keySize;
+  resolvedPath = std::string_view{value, record->valueSize};
+  return true;
+}
+
+void SharedResolutionCache::publishResolution(const std::string_view assetPath,
+                                              const std::size_t contextHash,
+                                              const std::string_view resolvedPath) noexcept {
+  publish(Kind::kResolution, assetPath,
+          Qualifier{contextHash, header_->generation.load(std::memory_order_acquire), 0},
+          resolvedPath);
+}
+
+void SharedResolutionCache::invalidateResolutions() noexcept {
+  header_->generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+bool SharedResolutionCache::findAsset(const std::string_view resolvedPath,
+                                      const AssetBufferCache::FileStamp &stamp,
+                                      AssetBufferCache::Buffer &buffer) const noexcept {
+  const Record *record =
+      find(Kind::kAsset, resolvedPath,
+           Qualifier{static_cast<std::uint64_t>(stamp.modificationTimeNs), stamp.size,
+                     stamp.inode});
+  if (!record) {
+    return false;
+  }
+  const char *contents = reinterpret_cast<const char *>(record + 1) + record->keySize;
+  // Aliases the mapping, keeping it alive for as long as the buffer.
+  buffer = AssetBufferCache::Buffer{std::shared_ptr<const char>{mapping_, contents},
+                                    record->valueSize};
+  return true;
+}
+
+void SharedResolutionCache::publishAsset(const std::string_view resolvedPath,
+                                         const AssetBufferCache::FileStamp &stamp,
+                                         const std::string_view contents) noexcept {
+  if (contents.size() > header_->arenaSize / 4) {
+    rejections_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  publish(Kind::kAsset, resolvedPath,
+          Qualifier{static_cast<std::uint64_t>(stamp.modificationTimeNs), stamp.size,
+                    stamp.inode},
+          contents);
+}
+
+CacheStats SharedResolutionCache::stats() const {
+  CacheStats result;
+  result.hits = hits_.load(std::memory_order_relaxed);
+  result.misses = misses_.load(std::memory_order_relaxed);
+  result.insertions = insertions_.load(std::memory_order_relaxed);
+  result.rejections = rejections_.load(std::memory_order_relaxed);
+  // Shared by every process using the segment.
+  result.entries = header_->slotsClaimed.load(std::memory_order_relaxed);
+  result.bytes = header_->arenaOffset +
+                 std::min(header_->arenaUsed.load(std::memory_order_relaxed), header_->arenaSize);
+  result.budgetBytes = mapping_->size;
+  return result;
+}
+
+namespace {
+std::uint64_t recordHash(const std::uint32_t kind, const std::string_view key,
+                         const std::array<std::uint64_t, 3> &qualifier) noexcept {
+  std::uint64_t hash = fnv1a(key) ^ kind;
+  for (const std::uint64_t part : qualifier) {
+    hash = mix(hash ^ part);
+  }
+  // Zero marks an empty slot.
+  return hash == 0 ? 1 : hash;
+}
+}  // namespace
+
+const SharedResolutionCache::Record *SharedResolutionCache::find(
+    const Kind kind, const std::string_view key, const Qualifier &qualifier) const noexcept {
+  const std::uint64_t hash = recordHash(static_cast<std::uint32_t>(kind), key, qualifier);
+  const std::uint64_t mask = header_->slotCount - 1;
+  for (std::uint64_t probe = 0, idx = hash & mask; probe < header_->slotCount;
+       ++probe, idx = (idx + 1) & mask) {
+    const std::uint64_t slotHash = slots_[idx].hash.load(std::memory_order_acquire);
+    if (slotHash == 0) {
+      break;
+    }
+    if (slotHash != hash) {
+      continue;
+    }
+    const std::uint64_t offset = slots_[idx].offset.load(std::memory_order_acquire);
+    // Records are only ever written by this code, but the segment is
+    // writable by any process, so bounds are checked regardless.
+    if (offset < kFirstRecordOffset || offset > header_->arenaSize - sizeof(Record)) {
+      continue;
+    }
+    const auto *record = reinterpret_cast<const Record *>(arena_ + offset);
+    const std::uint64_t remaining = header_->arenaSize - offset - sizeof(Record);
+    if (record->kind == kind && record->qualifier == qualifier && record->keySize == key.size() &&
+        key.size() <= remaining && record->valueSize <= remaining - key.size() &&
+        std::string_view{reinterpret_cast<const char *>(record + 1), record->keySize} == key) {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return record;
+    }
+  }
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return nullptr;
+}
+
+bool SharedResolutionCache::publish(const Kind kind, const std::string_view key,
+                                    const Qualifier &qualifier,
+                                    const std::string_view value) noexcept {
+  const std::size_t recordSize =
+      alignUp(sizeof(Record) + key.size() + value.size(), alignof(Record));
+  if (recordSize > header_->arenaSize) {
+    rejections_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  // Keep the index at most 3/4 full, so probes stay short.
+  if (header_->slotsClaimed.fetch_add(1, std::memory_order_relaxed) >=
+      header_->slotCount / 4 * 3) {
+    header_->slotsClaimed.fetch_sub(1, std::memory_order_relaxed);
+    rejections_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  const std::uint64_t hash = recordHash(static_cast<std::uint32_t>(kind), key, qualifier);
+  const std::uint64_t mask = header_->slotCount - 1;
+  Slot *slot = nullptr;
+  for (std::uint64_t idx = hash & mask; !slot; idx = (idx + 1) & mask) {
+    std::uint64_t slotHash = 0;
+    if (slots_[idx].hash.compare_exchange_strong(slotHash, hash, std::memory_order_acq_rel)) {
+      slot = &slots_[idx];
+    } else if (slotHash == hash) {
+      // Published concurrently, or already. A slot still being
+      // written is passed over, so the key may be published twice,
+      // which is harmless.
+      const std::uint64_t offset = slots_[idx].offset.load(std::memory_order_acquire);
+      if (offset >= kFirstRecordOffset && offset <= header_->arenaSize - sizeof(Record)) {
+        const auto *record = reinterpret_cast<const Record *>(arena_ + offset);
+        if (record->kind == kind && record->qualifier == qualifier &&
+            record->keySize == key.size() &&
+            key.size() <= header_->arenaSize - offset - sizeof(Record) &&
+            std::string_view{reinterpret_cast<const char *>(record + 1), key.size()} == key) {
+          header_->slotsClaimed.fetch_sub(1, std::memory_order_relaxed);
+          return true;
+        }
+      }
+    }
+  }
+
+  const std::uint64_t offset = header_->arenaUsed.fetch_add(recordSize, std::memory_order_relaxed);
+  if (offset > header_->arenaSize - recordSize) {
+    slot->offset.store(kAbandoned, std::memory_order_release);
+    rejections_.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  auto *record = reinterpret_cast<Record *>(arena_ + offset);
+  *record = Record{kind, static_cast<std::uint32_t>(key.size()), value.size(), qualifier};
+  char *data = reinterpret_cast<char *>(record + 1);
+  std::memcpy(data, key.data(), key.size());
+  std::memcpy(data + key.size(), value.data(), value.size());
+  slot->offset.store(offset, std::memory_order_release);
+  insertions_.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "assetBufferCache.h"
+#include "cacheStats.h"
+
+/**
+ * Cache of entity reference resolutions, and optionally file
+ * contents, in a named POSIX shared memory segment, so that processes
+ * on the same host, e.g. the render tasks of one job, share each
+ * other's manager queries and file reads.
+ *
+ * The segment is a header, an open-addressed index of slots, and an
+ * append-only arena of records. Every operation is lock-free: a
+ * publisher claims an index slot by compare-and-swap of its hash,
+ * reserves arena space by fetch-and-add, writes the record, and only
+ * then publishes its offset. Readers skip slots not yet published,
+ * so never see partial records, and a process dying mid-publish
+ * leaves at worst an unused slot. Entries are never replaced or
+ * removed; once the index or arena is full, further publishes are
+ * dropped. Resolutions are instead invalidated all together, by
+ * bumping a generation number in the header that qualifies them.
+ *
+ * Keys are hashed with a hash stable between processes, but context
+ * hashes are as computed by the resolver, so only processes of the
+ * same build should share a segment.
+ *
+ * The segment outlives the processes using it, to be reused by later
+ * ones, until unlinked.
+ */
+class SharedResolutionCache {
+ public:
+  /// Open the named segment, creating it with the given size if it
+  /// does not exist. An existing segment is used at whatever size it
+  /// was created with. Returns nullptr, with a warning, on failure.
+  static std::unique_ptr<SharedResolutionCache> open(const std::string &name,
+                                                     std::size_t sizeBytes);
+
+  /// Remove the named segment. Processes with it open keep using it.
+  static bool unlink(const std::string &name);
+
+  ~SharedResolutionCache();
+
+  SharedResolutionCache(const SharedResolutionCache &) = delete;
+  SharedResolutionCache &operator=(const SharedResolutionCache &) = delete;
+
+  /// Look up a resolution. The result points into the segment, so is
+  /// valid for the lifetime of this object.
+  bool findResolution(std::string_view assetPath, std::size_t contextHash,
+                      std::string_view &resolvedPath) const noexcept;
+
+  void publishResolution(std::string_view assetPath, std::size_t contextHash,
+                         std::string_view resolvedPath) noexcept;
+
+  /// Stop finding the resolutions published so far, by any process,
+  /// e.g. as the resolver context is refreshed. Their space is not
+  /// reclaimed.
+  void invalidateResolutions() noexcept;
+
+  /// Look up the contents of a version of a file. The buffer shares
+  /// ownership of the segment's mapping.
+  bool findAsset(std::string_view resolvedPath, const AssetBufferCache::FileStamp &stamp,
+                 AssetBufferCache::Buffer &buffer) const noexcept;
+
+  /// Publish the contents of a version of a file, unless larger than
+  /// a quarter of the arena.
+  void publishAsset(std::string_view resolvedPath, const AssetBufferCache::FileStamp &stamp,
+                    std::string_view contents) noexcept;
+
+  [[nodiscard]] CacheStats stats() const;
+
+ private:
+  struct Header;
+  struct Slot;
+  struct Record;
+  struct Mapping;
+
+  enum class Kind : std::uint32_t { kResolution = 1, kAsset = 2 };
+  // Distinguishes records with the same key: the context hash of a
+  // resolution, or the file stamp of an asset.
+  using Qualifier = std::array<std::uint64_t, 3>;
+
+  explicit SharedResolutionCache(std::shared_ptr<Mapping> mapping);
+
+  [[nodiscard]] const Record *find(Kind kind, std::string_view key,
+                                   const Qualifier &qualifier) const noexcept;
+
+  bool publish(Kind kind, std::string_view key, const Qualifier &qualifier,
+               std::string_view value) noexcept;
+
+  std::shared_ptr<Mapping> mapping_;
+  Header *header_;
+  Slot *slots_;
+  char *arena_;
+  mutable std::atomic<std::uint64_t> hits_{0};
+  mutable std::atomic<std::uint64_t> misses_{0};
+  std::atomic<std::uint64_t> insertions_{0};
+  std::atomic<std::uint64_t> rejections_{0};
+};
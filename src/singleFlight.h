@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Coalesces concurrent computations of the same value.
+ *
+ * The first caller of `run` for a key computes the value. Callers for
+ * the same key that arrive whilst it is in flight wait for, and share,
+ * that result (or exception) rather than computing it again. Nothing
+ * is retained once the computation completes, so this is not a cache.
+ *
+ * In-flight keys are spread across independently locked shards, so
+ * unrelated keys rarely contend.
+ */
+template <class Key, class Value, class Hash = std::hash<Key>>
+class SingleFlight {
+ public:
+  template <class Fn>
+  Value run(const Key &key, Fn &&compute) {
+    Shard &shard = shards_[Hash{}(key) % kShardCount];
+
+    std::unique_lock lock{shard.mutex};
+    if (const auto iter = shard.inFlight.find(key); iter != shard.inFlight.end()) {
+      const std::shared_future<Value> result = iter->second;
+      lock.unlock();
+      return result.get();
+    }
+    std::promise<Value> promise;
+    shard.inFlight.emplace(key, promise.get_future().share());
+    lock.unlock();
+
+    try {
+      Value value = std::forward<Fn>(compute)();
+      promise.set_value(value);
+      finish(shard, key);
+      return value;
+    } catch (...) {
+      promise.set_exception(std::current_exception());
+      finish(shard, key);
+      throw;
+    }
+  }
+
+ private:
+  static constexpr std::size_t kShardCount = 16;
+
+  struct Shard {
+    std::mutex mutex;
+    std::unordered_map<Key, std::shared_future<Value>, Hash> inFlight;
+  };
+
+  static void finish(Shard &shard, const Key &key) {
+    const std::lock_guard lock{shard.mutex};
+    shard.inFlight.erase(key);
+  }
+
+  std::array<Shard, kShardCount> shards_;
+};
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "threadResolveCache.h"
+
+#include <atomic>
+#include <memory>
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+std::atomic<std::uint64_t> nextOwnerId{1};
+// Starts above zero, which marks empty ways.
+std::atomic<std::uint64_t> currentGeneration{1};
+}  // namespace
+
+std::uint64_t ThreadResolveCache::newOwnerId() noexcept {
+  return nextOwnerId.fetch_add(1, std::memory_order_relaxed);
+}
+
+ThreadResolveCache &ThreadResolveCache::forThread(const std::uint64_t ownerId) noexcept {
+  // Allocated on first use, since the entries are too large for some
+  // platforms' static TLS.
+  thread_local const auto cache = std::make_unique<ThreadResolveCache>();
+  if (cache->ownerId_ != ownerId) {
+    cache->ownerId_ = ownerId;
+    cache->tags_ = {};
+  }
+  return *cache;
+}
+
+std::uint64_t ThreadResolveCache::generation() noexcept {
+  return currentGeneration.load(std::memory_order_acquire);
+}
+
+void ThreadResolveCache::invalidateAll() noexcept {
+  currentGeneration.fetch_add(1, std::memory_order_acq_rel);
+}
+
+bool ThreadResolveCache::find(const std::size_t hash, const std::uint64_t generation,
+                              const std::string_view assetPath, const std::size_t contextHash,
+                              ArResolvedPath &resolvedPath) const {
+  const std::size_t set = setIndex(hash);
+  const Tags &tags = tags_[set];
+  for (std::size_t way = 0; way < kWayCount; ++way) {
+    if (tags.hashes[way] != hash || tags.generations[way] != generation) {
+      continue;
+    }
+    const Entry &entry = entries_[set * kWayCount + way];
+    if (entry.contextHash == contextHash && entry.assetPath == assetPath) {
+      resolvedPath = entry.resolvedPath;
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadResolveCache::insert(const std::size_t hash, const std::uint64_t generation,
+                                const std::string_view assetPath, const std::size_t contextHash,
+                                const ArResolvedPath &resolvedPath) {
+  const std::size_t set = setIndex(hash);
+  Tags &tags = tags_[set];
+  // Prefer a way that is empty or from an old generation, otherwise
+  // evict round-robin.
+  std::size_t victim = kWayCount;
+  for (std::size_t way = 0; way < kWayCount; ++way) {
+    if (tags.generations[way] != generation) {
+      victim = way;
+      break;
+    }
+  }
+  if (victim == kWayCount) {
+    victim = nextVictim_++ % kWayCount;
+  }
+  tags.hashes[victim] = hash;
+  tags.generations[victim] = generation;
+  Entry &entry = entries_[set * kWayCount + victim];
+  entry.assetPath.assign(assetPath);
+  entry.contextHash = contextHash;
+  entry.resolvedPath = resolvedPath;
+}
+
+std::size_t ThreadResolveCache::setIndex(const std::size_t hash) noexcept {
+  return hash % kSetCount;
+}
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include <pxr/usd/ar/resolvedPath.h>
+
+/**
+ * A small, per-thread, 4-way set-associative cache of resolved paths,
+ * consulted before any shared cache so that the hot references on
+ * each composition thread are found without synchronisation.
+ *
+ * The tags for each set (hashes and generations) share a single cache
+ * line, so a lookup touches one line until a tag matches. Entries are
+ * invalidated lazily by bumping a process-wide generation counter.
+ */
+class ThreadResolveCache {
+ public:
+  static constexpr std::size_t kSetCount = 64;
+  static constexpr std::size_t kWayCount = 4;
+
+  /// A unique identifier for a new owner, e.g. a resolver instance.
+  static std::uint64_t newOwnerId() noexcept;
+
+  /// The calling thread's cache, emptied first if it was last used by
+  /// a different owner.
+  static ThreadResolveCache &forThread(std::uint64_t ownerId) noexcept;
+
+  /// The current generation. Lookups and inserts are made at a
+  /// generation read before the underlying resolve, so that results
+  /// computed across an invalidation are never found.
+  static std::uint64_t generation() noexcept;
+
+  /// Invalidate the entries of every thread's cache.
+  static void invalidateAll() noexcept;
+
+  bool find(std::size_t hash, std::uint64_t generation, std::string_view assetPath,
+            std::size_t contextHash, PXR_NS::ArResolvedPath &resolvedPath) const;
+
+  void insert(std::size_t hash, std::uint64_t generation, std::string_view assetPath,
+              std::size_t contextHash, const PXR_NS::ArResolvedPath &resolvedPath);
+
+ private:
+  struct alignas(64) Tags {
+    std::array<std::uint64_t, kWayCount> hashes{};
+    // Zero marks an empty way.
+    std::array<std::uint64_t, kWayCount> generations{};
+  };
+
+  struct Entry {
+    std::string assetPath;
+    std::size_t contextHash{};
+    PXR_NS::ArResolvedPath resolvedPath;
+  };
+
+  static std::size_t setIndex(std::size_t hash) noexcept;
+
+  std::uint64_t ownerId_{0};
+  std::size_t nextVictim_{0};
+  std::array<Tags, kSetCount> tags_{};
+  std::array<Entry, kSetCount * kWayCount> entries_{};
+};
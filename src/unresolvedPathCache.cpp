@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "unresolvedPathCache.h"
+
+#include <algorithm>
+
+#include "resolvedPathCache.h"
+
+UnresolvedPathCache::UnresolvedPathCache(const Clock::duration timeToLive,
+                                         const std::size_t capacity)
+    : timeToLive_{timeToLive}, shardCapacity_{std::max<std::size_t>(1, capacity / kShardCount)} {}
+
+bool UnresolvedPathCache::contains(const std::string_view assetPath,
+                                   const std::size_t contextHash) const {
+  const std::size_t hash = ResolveKey::hash(assetPath, contextHash);
+  const Shard &shard = shards_[shardIndex(hash)];
+  const auto now = Clock::now();
+
+  const std::lock_guard lock{shard.mutex};
+  const auto [begin, end] = shard.entries.equal_range(hash);
+  for (auto iter = begin; iter != end; ++iter) {
+    const Entry &entry = iter->second;
+    if (entry.contextHash == contextHash && entry.assetPath == assetPath) {
+      return entry.expiry > now;
+    }
+  }
+  return false;
+}
+
+void UnresolvedPathCache::insert(const std::string_view assetPath,
+                                 const std::size_t contextHash) {
+  const std::size_t hash = ResolveKey::hash(assetPath, contextHash);
+  Shard &shard = shards_[shardIndex(hash)];
+  const auto expiry = Clock::now() + timeToLive_;
+
+  const std::lock_guard lock{shard.mutex};
+  while (shard.order.size() >= shardCapacity_) {
+    evictOldest(shard);
+  }
+  shard.order.emplace_back(hash, expiry);
+
+  const auto [begin, end] = shard.entries.equal_range(hash);
+  for (auto iter = begin; iter != end; ++iter) {
+    Entry &entry = iter->second;
+    if (entry.contextHash == contextHash && entry.assetPath == assetPath) {
+      entry.expiry = expiry;
+      return;
+    }
+  }
+  shard.entries.emplace(hash, Entry{std::string{assetPath}, contextHash, expiry});
+}
+
+void UnresolvedPathCache::erase(const std::string_view assetPath,
+                                const std::size_t contextHash) {
+  const std::size_t hash = ResolveKey::hash(assetPath, contextHash);
+  Shard &shard = shards_[shardIndex(hash)];
+
+  // Its place in the order is left, to be skipped when reached.
+  const std::lock_guard lock{shard.mutex};
+  const auto [begin, end] = shard.entries.equal_range(hash);
+  for (auto iter = begin; iter != end; ++iter) {
+    const Entry &entry = iter->second;
+    if (entry.contextHash == contextHash && entry.assetPath == assetPath) {
+      shard.entries.erase(iter);
+      return;
+    }
+  }
+}
+
+void UnresolvedPathCache::clear() {
+  for (Shard &shard : shards_) {
+    const std::lock_guard lock{shard.mutex};
+    shard.entries.clear();
+    shard.order.clear();
+  }
+}
+
+std::size_t UnresolvedPathCache::shardIndex(const std::size_t hash) noexcept {
+  // Use different bits to those that pick the bucket within a shard.
+  return (hash >> 16U) % kShardCount;
+}
+
+void UnresolvedPathCache::evictOldest(Shard &shard) {
+  const auto [hash, expiry] = shard.order.front();
+  shard.order.pop_front();
+  // An entry reinserted since has a later expiry, and a later place in
+  // the order, so is left alone.
+  const auto [begin, end] = shard.entries.equal_range(hash);
+  for (auto iter = begin; iter != end; ++iter) {
+    if (iter->second.expiry == expiry) {
+      shard.entries.erase(iter);
+      return;
+    }
+  }
+}
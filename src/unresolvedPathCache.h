@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Process-wide cache of asset paths that failed to resolve, so that
+ * broken references are not queried again on every composition pass.
+ *
+ * Entries expire after a fixed time to live, so that assets published
+ * or created later are eventually found. The number of entries is
+ * bounded, the oldest being evicted first, which, since all entries
+ * live equally long, are also the first to expire.
+ *
+ * Like ResolvedPathCache, entries are keyed by asset path and context
+ * hash, and spread across independently locked shards. Lookups do not
+ * allocate.
+ */
+class UnresolvedPathCache {
+ public:
+  using Clock = std::chrono::steady_clock;
+
+  UnresolvedPathCache(Clock::duration timeToLive, std::size_t capacity);
+
+  /// Whether the asset path recently failed to resolve.
+  bool contains(std::string_view assetPath, std::size_t contextHash) const;
+
+  /// Record that the asset path failed to resolve.
+  void insert(std::string_view assetPath, std::size_t contextHash);
+
+  /// Forget that the asset path failed to resolve, e.g. as it is
+  /// written.
+  void erase(std::string_view assetPath, std::size_t contextHash);
+
+  /// Remove all entries.
+  void clear();
+
+ private:
+  static constexpr std::size_t kShardCount = 16;
+
+  struct Entry {
+    std::string assetPath;
+    std::size_t contextHash;
+    Clock::time_point expiry;
+  };
+
+  // Keyed by the full hash, see ResolvedPathCache. Insertion order is
+  // kept as (hash, expiry) pairs, for eviction.
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    std::unordered_multimap<std::size_t, Entry> entries;
+    std::deque<std::pair<std::size_t, Clock::time_point>> order;
+  };
+
+  static std::size_t shardIndex(std::size_t hash) noexcept;
+
+  // Remove the oldest entry of a shard, unless since reinserted or
+  // erased.
+  static void evictOldest(Shard &shard);
+
+  const Clock::duration timeToLive_;
+  const std::size_t shardCapacity_;
+  std::array<Shard, kShardCount> shards_;
+};
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+#include "versionPins.h"
+
+#include <cstdlib>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "resolutionManifest.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+VersionPins &VersionPins::instance() {
+  // Deliberately leaked, see header.
+  static auto *const instance = new VersionPins;  // NOLINT(cppcoreguidelines-owning-memory)
+  return *instance;
+}
+
+bool VersionPins::load(const std::string &path) {
+  const std::unique_ptr<ResolutionManifest> manifest = ResolutionManifest::open(path);
+  if (!manifest) {
+    return false;
+  }
+  manifest->forEach([this](const std::string_view assetPath, const std::string_view resolved) {
+    pins_.insertIfAbsent(assetPath, kAnyContext, ArResolvedPath{std::string{resolved}});
+  });
+  return true;
+}
+
+bool VersionPins::find(const std::string_view assetPath, const std::size_t contextHash,
+                       ArResolvedPath &resolvedPath) const {
+  return pins_.find(assetPath, contextHash, resolvedPath) ||
+         pins_.find(assetPath, kAnyContext, resolvedPath);
+}
+
+ArResolvedPath VersionPins::pin(const std::string_view assetPath, const std::size_t contextHash,
+                                const ArResolvedPath &resolvedPath) {
+  return pins_.insertIfAbsent(assetPath, contextHash, resolvedPath);
+}
+
+void VersionPins::unpin(const std::size_t contextHash) {
+  if (contextHash != kAnyContext) {
+    pins_.eraseContext(contextHash);
+  }
+}
+
+bool VersionPins::write(const std::string &path) const {
+  std::vector<std::pair<std::string, std::string>> entries;
+  pins_.forEach([&entries](const std::string_view assetPath, std::size_t /*contextHash*/,
+                           const ArResolvedPath &resolvedPath) {
+    entries.emplace_back(assetPath, resolvedPath.GetPathString());
+  });
+  return ResolutionManifest::write(path, std::move(entries));
+}
+
+void VersionPins::writeAtExit(std::string path) {
+  const std::lock_guard lock{exitPathMutex_};
+  if (exitPath_.empty()) {
+    std::atexit(&VersionPins::writeOnExit);
+  }
+  exitPath_ = std::move(path);
+}
+
+void VersionPins::writeOnExit() {
+  VersionPins &pins = instance();
+  const std::lock_guard lock{pins.exitPathMutex_};
+  pins.write(pins.exitPath_);
+}
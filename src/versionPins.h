@@ -0,0 +1,69 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include <pxr/usd/ar/resolvedPath.h>
+
+#include "internedPathMemo.h"
+
+/**
+ * Process-wide table of the first resolution of each entity reference
+ * in each resolver context, so that references to a floating version
+ * (e.g. "latest") resolve to the same version for the rest of the
+ * session, however many times they are resolved and whatever the
+ * manager publishes in the meantime.
+ *
+ * Pins made in a context last until that context is refreshed. The
+ * table can be saved as a resolution manifest and loaded by later
+ * processes, e.g. every task of a farm job, so that all see the same
+ * versions. Loaded pins apply in every context, and are never
+ * forgotten.
+ */
+class VersionPins {
+ public:
+  /// The process-wide instance. Never destroyed, so is safe to use
+  /// from exit handlers.
+  static VersionPins &instance();
+
+  /// Pin the resolutions in a manifest file, in every context. Pins
+  /// already made take precedence. Returns false, with a warning, if
+  /// the file cannot be read.
+  bool load(const std::string &path);
+
+  /// Look up the pinned resolution of an entity reference.
+  bool find(std::string_view assetPath, std::size_t contextHash,
+            PXR_NS::ArResolvedPath &resolvedPath) const;
+
+  /// Pin a resolution, unless one was pinned concurrently, returning
+  /// the pinned resolution.
+  PXR_NS::ArResolvedPath pin(std::string_view assetPath, std::size_t contextHash,
+                             const PXR_NS::ArResolvedPath &resolvedPath);
+
+  /// Forget the pins made in a context, e.g. as it is refreshed.
+  void unpin(std::size_t contextHash);
+
+  /// Write the pins as a resolution manifest. Where contexts pinned an
+  /// entity reference differently, an arbitrary one is kept.
+  bool write(const std::string &path) const;
+
+  /// Write the pins as a resolution manifest when the process exits.
+  void writeAtExit(std::string path);
+
+ private:
+  // Context hash of pins that apply in every context.
+  static constexpr std::size_t kAnyContext = std::numeric_limits<std::size_t>::max();
+
+  VersionPins() = default;
+
+  static void writeOnExit();
+
+  InternedPathMemo pins_;
+  std::mutex exitPathMutex_;
+  std::string exitPath_;
+};
@@ -0,0 +1,97 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#include <cstddef>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include "budgetedCache.h"
+
+namespace {
+// 16 KiB a shard, i.e. around a hundred small entries, and a frequency
+// sketch sized for 64, so aged after 640 increments.
+constexpr std::size_t kBudgetBytes = std::size_t{1} << 20U;
+// Three times as many one-off keys as fit, yet few enough that the
+// frequency sketch is not aged mid-scan.
+constexpr std::size_t kScanSize = 20000;
+// Enough to saturate the hot key's frequency.
+constexpr std::size_t kHotLookups = 16;
+constexpr std::size_t kContextHash = 0;
+
+std::string scanKey(const std::size_t idx) { return "bal:///" + std::to_string(idx); }
+
+// Look up each key once, then insert it, as on a resolver cache miss.
+template <class Value>
+void scan(BudgetedCache<Value> &cache) {
+  for (std::size_t idx = 0; idx < kScanSize; ++idx) {
+    Value value{};
+    if (!cache.find(scanKey(idx), kContextHash, value)) {
+      cache.insert(scanKey(idx), kContextHash, static_cast<Value>(idx));
+    }
+  }
+}
+}  // namespace
+
+TEST_CASE("a scan of one-off keys does not flush a frequently used entry", "[BudgetedCache]") {
+  BudgetedCache<int> cache{kBudgetBytes};
+  int value = 0;
+
+  // Given an entry that has been used frequently
+  cache.insert("bal:///hot", kContextHash, -1);
+  for (std::size_t idx = 0; idx < kHotLookups; ++idx) {
+    REQUIRE(cache.find("bal:///hot", kContextHash, value));
+  }
+
+  // When more one-off keys than fit are looked up and inserted
+  scan(cache);
+
+  // Then the frequently used entry is kept, as it would not be by an
+  // LRU cache, whilst the one-off keys are evicted or refused
+  CHECK(cache.find("bal:///hot", kContextHash, value));
+  CHECK(value == -1);
+  const CacheStats stats = cache.stats();
+  CHECK(stats.evictions > 0);
+  CHECK(stats.rejections > 0);
+  CHECK(stats.entries < kScanSize);
+}
+
+TEST_CASE("a bounded cache stays within its budget", "[BudgetedCache]") {
+  BudgetedCache<int> cache{kBudgetBytes};
+
+  // When more keys than fit are inserted
+  scan(cache);
+
+  // Then the entries held are charged no more than the budget
+  const CacheStats stats = cache.stats();
+  CHECK(stats.budgetBytes == kBudgetBytes);
+  CHECK(stats.bytes <= kBudgetBytes);
+  CHECK(stats.insertions == kScanSize);
+  CHECK(stats.entries + stats.evictions == kScanSize);
+}
+
+TEST_CASE("recently inserted entries are admitted to the window", "[BudgetedCache]") {
+  BudgetedCache<int> cache{kBudgetBytes};
+  scan(cache);
+
+  // When a new key is inserted into a full cache
+  cache.insert("bal:///new", kContextHash, 1);
+
+  // Then it is found straight away, before competing for admission
+  int value = 0;
+  CHECK(cache.find("bal:///new", kContextHash, value));
+  CHECK(value == 1);
+}
+
+TEST_CASE("an unbounded cache never evicts", "[BudgetedCache]") {
+  BudgetedCache<int> cache;
+
+  // When many keys are inserted
+  scan(cache);
+
+  // Then all are kept
+  const CacheStats stats = cache.stats();
+  CHECK(stats.entries == kScanSize);
+  CHECK(stats.evictions == 0);
+  int value = 0;
+  CHECK(cache.find(scanKey(0), kContextHash, value));
+}
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#include <cstddef>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include <pxr/usd/ar/resolvedPath.h>
+
+#include "internedPathMemo.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+// Enough entries to outgrow the initial table several times.
+constexpr std::size_t kManyEntries = 10000;
+constexpr std::size_t kContextHash = 1;
+constexpr std::size_t kOtherContextHash = 2;
+
+std::string assetPath(const std::size_t idx) { return "bal:///asset/" + std::to_string(idx); }
+
+std::string resolvedPath(const std::size_t idx) {
+  return "/show/assets/" + std::to_string(idx) + "/v1/geo.usd";
+}
+}  // namespace
+
+TEST_CASE("resolutions are remembered per context", "[InternedPathMemo]") {
+  InternedPathMemo memo;
+  memo.insert("bal:///cat", kContextHash, ArResolvedPath{"/context1/cat.usd"});
+  memo.insert("bal:///cat", kOtherContextHash, ArResolvedPath{"/context2/cat.usd"});
+
+  ArResolvedPath found;
+  REQUIRE(memo.find("bal:///cat", kContextHash, found));
+  CHECK(found.GetPathString() == "/context1/cat.usd");
+  REQUIRE(memo.find("bal:///cat", kOtherContextHash, found));
+  CHECK(found.GetPathString() == "/context2/cat.usd");
+  CHECK(memo.size() == 2);
+}
+
+TEST_CASE("asset paths that are absent or only prefixes are not found", "[InternedPathMemo]") {
+  InternedPathMemo memo;
+  memo.insert("bal:///cat.usd", kContextHash, ArResolvedPath{"/cat.usd"});
+  ArResolvedPath found;
+
+  CHECK(!memo.find("bal:///dog.usd", kContextHash, found));
+  CHECK(!memo.find("bal:///cat", kContextHash, found));
+  CHECK(!memo.find("bal:///cat.usd.bak", kContextHash, found));
+  CHECK(!memo.find("bal:///cat.usd", kOtherContextHash, found));
+  // Nor are resolved paths, interned alongside.
+  CHECK(!memo.find("/cat.usd", kContextHash, found));
+}
+
+TEST_CASE("insert replaces, insertIfAbsent keeps, the existing entry", "[InternedPathMemo]") {
+  InternedPathMemo memo;
+  memo.insert("bal:///cat", kContextHash, ArResolvedPath{"/v1/cat.usd"});
+
+  CHECK(memo.insertIfAbsent("bal:///cat", kContextHash, ArResolvedPath{"/v2/cat.usd"})
+            .GetPathString() == "/v1/cat.usd");
+  memo.insert("bal:///cat", kContextHash, ArResolvedPath{"/v3/cat.usd"});
+
+  ArResolvedPath found;
+  REQUIRE(memo.find("bal:///cat", kContextHash, found));
+  CHECK(found.GetPathString() == "/v3/cat.usd");
+  CHECK(memo.size() == 1);
+}
+
+TEST_CASE("many entries are remembered past the first rehash", "[InternedPathMemo]") {
+  InternedPathMemo memo;
+  for (std::size_t idx = 0; idx < kManyEntries; ++idx) {
+    memo.insert(assetPath(idx), kContextHash, ArResolvedPath{resolvedPath(idx)});
+  }
+
+  CHECK(memo.size() == kManyEntries);
+  for (std::size_t idx = 0; idx < kManyEntries; ++idx) {
+    ArResolvedPath found;
+    REQUIRE(memo.find(assetPath(idx), kContextHash, found));
+    REQUIRE(found.GetPathString() == resolvedPath(idx));
+  }
+  std::size_t visited = 0;
+  memo.forEach([&visited](std::string_view /*assetPath*/, std::size_t /*contextHash*/,
+                          const ArResolvedPath & /*resolvedPath*/) { ++visited; });
+  CHECK(visited == kManyEntries);
+}
+
+TEST_CASE("erasing a context keeps the entries of others", "[InternedPathMemo]") {
+  InternedPathMemo memo;
+  for (std::size_t idx = 0; idx < kManyEntries; ++idx) {
+    memo.insert(assetPath(idx), idx % 2 == 0 ? kContextHash : kOtherContextHash,
+                ArResolvedPath{resolvedPath(idx)});
+  }
+
+  memo.eraseContext(kContextHash);
+
+  CHECK(memo.size() == kManyEntries / 2);
+  for (std::size_t idx = 0; idx < kManyEntries; ++idx) {
+    ArResolvedPath found;
+    if (idx % 2 == 0) {
+      REQUIRE(!memo.find(assetPath(idx), kContextHash, found));
+    } else {
+      REQUIRE(memo.find(assetPath(idx), kOtherContextHash, found));
+      REQUIRE(found.GetPathString() == resolvedPath(idx));
+    }
+  }
+}
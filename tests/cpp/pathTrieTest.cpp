@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "pathTrie.h"
+
+namespace {
+// Enough paths to outgrow the initial child table, and the first
+// blocks of nodes and labels.
+constexpr std::size_t kManyPaths = 100000;
+
+std::string manyPath(const std::size_t idx) {
+  return "/show/seq" + std::to_string(idx % 100) + "/shot" + std::to_string(idx) +
+         "/publish/geo_v" + std::to_string(idx % 7) + ".usd";
+}
+}  // namespace
+
+TEST_CASE("interned paths are rebuilt from their handles", "[PathTrie]") {
+  PathTrie trie;
+
+  const PathTrie::Handle cat = trie.intern("/show/assets/cat.usd");
+  const PathTrie::Handle dog = trie.intern("/show/assets/dog.usd");
+
+  CHECK(cat != dog);
+  CHECK(trie.path(cat) == "/show/assets/cat.usd");
+  CHECK(trie.path(dog) == "/show/assets/dog.usd");
+  CHECK(trie.intern("/show/assets/cat.usd") == cat);
+  CHECK(trie.size() == 2);
+}
+
+TEST_CASE("prefixes and extensions of interned paths are interned", "[PathTrie]") {
+  PathTrie trie;
+  const PathTrie::Handle path = trie.intern("/show/assets/cat.usd");
+
+  // When a prefix, splitting an edge, and an extension are interned
+  const PathTrie::Handle prefix = trie.intern("/show/assets");
+  const PathTrie::Handle extension = trie.intern("/show/assets/cat.usd.bak");
+
+  // Then each is its own path, and the original is unchanged
+  CHECK(trie.path(prefix) == "/show/assets");
+  CHECK(trie.path(extension) == "/show/assets/cat.usd.bak");
+  CHECK(trie.path(path) == "/show/assets/cat.usd");
+  CHECK(trie.size() == 3);
+
+  PathTrie::Handle found = 0;
+  REQUIRE(trie.find("/show/assets/cat.usd", found));
+  CHECK(found == path);
+  REQUIRE(trie.find("/show/assets", found));
+  CHECK(found == prefix);
+}
+
+TEST_CASE("paths that are absent or only prefixes are not found", "[PathTrie]") {
+  PathTrie trie;
+  const PathTrie::Handle path = trie.intern("/show/assets/cat.usd");
+  PathTrie::Handle found = 0;
+
+  CHECK(!trie.find("/show/assets/dog.usd", found));
+  // A prefix of an interned path, ending mid-label and at a node.
+  CHECK(!trie.find("/show/ass", found));
+  CHECK(!trie.find("/show/assets/cat", found));
+  CHECK(!trie.find("/show/assets/cat.usd.bak", found));
+  CHECK(!trie.find("", found));
+
+  CHECK(trie.equals(path, "/show/assets/cat.usd"));
+  CHECK(!trie.equals(path, "/show/assets/cat"));
+  CHECK(!trie.equals(path, "/show/assets/cat.usd.bak"));
+  CHECK(!trie.equals(path, "/show/assets/dog.usd"));
+  CHECK(!trie.equals(path, "show/assets/cat.usd"));
+}
+
+TEST_CASE("many paths are interned past the first growth", "[PathTrie]") {
+  PathTrie trie;
+  std::vector<PathTrie::Handle> handles;
+  handles.reserve(kManyPaths);
+  for (std::size_t idx = 0; idx < kManyPaths; ++idx) {
+    handles.push_back(trie.intern(manyPath(idx)));
+  }
+
+  CHECK(trie.size() == kManyPaths);
+  for (std::size_t idx = 0; idx < kManyPaths; ++idx) {
+    const std::string path = manyPath(idx);
+    PathTrie::Handle found = 0;
+    REQUIRE(trie.find(path, found));
+    REQUIRE(found == handles[idx]);
+    REQUIRE(trie.path(handles[idx]) == path);
+    REQUIRE(trie.equals(handles[idx], path));
+  }
+}
+
+TEST_CASE("a cleared trie is empty", "[PathTrie]") {
+  PathTrie trie;
+  trie.intern("/show/assets/cat.usd");
+
+  trie.clear();
+
+  PathTrie::Handle found = 0;
+  CHECK(trie.size() == 0);
+  CHECK(!trie.find("/show/assets/cat.usd", found));
+  const PathTrie::Handle cat = trie.intern("/show/assets/cat.usd");
+  CHECK(trie.path(cat) == "/show/assets/cat.usd");
+}
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include <pxr/usd/ar/defaultResolverContext.h>
+#include <pxr/usd/ar/resolvedPath.h>
+#include <pxr/usd/ar/resolverContext.h>
+
+#include "resolutionRevalidator.h"
+#include "resolvedPathCache.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+// Long enough that the background thread never runs a pass, so that
+// the tests drive passes themselves.
+constexpr std::chrono::hours kNeverInterval{24};
+constexpr std::size_t kContextHash = 1;
+constexpr std::size_t kUnregisteredContextHash = 2;
+}  // namespace
+
+TEST_CASE("a changed resolution is held back until applied", "[ResolutionRevalidator]") {
+  ResolvedPathCache cache;
+  cache.insert("bal:///cat", kContextHash, ArResolvedPath{"/v1/cat.usd"});
+  ResolutionRevalidator revalidator{
+      cache, kNeverInterval,
+      [](const std::string & /*assetPath*/, const ArResolverContext & /*context*/,
+         ArResolvedPath &resolvedPath) {
+        resolvedPath = ArResolvedPath{"/v2/cat.usd"};
+        return true;
+      }};
+  revalidator.addContext(kContextHash,
+                         ArResolverContext{ArDefaultResolverContext{{"/search"}}});
+
+  // When an entry is found to have changed
+  CHECK(revalidator.check() == 1);
+
+  // Then the cache is unchanged until the change is applied
+  ArResolvedPath cached;
+  REQUIRE(cache.find("bal:///cat", kContextHash, cached));
+  CHECK(cached.GetPathString() == "/v1/cat.usd");
+
+  const std::vector<ResolutionRevalidator::Change> changes = revalidator.apply();
+  REQUIRE(changes.size() == 1);
+  CHECK(changes[0].assetPath == "bal:///cat");
+  CHECK(changes[0].resolvedPath.GetPathString() == "/v2/cat.usd");
+  CHECK(!changes[0].context.IsEmpty());
+  REQUIRE(cache.find("bal:///cat", kContextHash, cached));
+  CHECK(cached.GetPathString() == "/v2/cat.usd");
+
+  // And is applied only once
+  CHECK(revalidator.apply().empty());
+}
+
+TEST_CASE("entries of unregistered contexts are not revalidated", "[ResolutionRevalidator]") {
+  ResolvedPathCache cache;
+  cache.insert("bal:///cat", kUnregisteredContextHash, ArResolvedPath{"/v1/cat.usd"});
+  std::size_t resolveCount = 0;
+  ResolutionRevalidator revalidator{
+      cache, kNeverInterval,
+      [&resolveCount](const std::string & /*assetPath*/, const ArResolverContext & /*context*/,
+                      ArResolvedPath &resolvedPath) {
+        ++resolveCount;
+        resolvedPath = ArResolvedPath{"/v2/cat.usd"};
+        return true;
+      }};
+
+  // When the entries are checked
+  CHECK(revalidator.check() == 0);
+
+  // Then the entry is not resolved, in an empty context, instead
+  CHECK(resolveCount == 0);
+  CHECK(revalidator.apply().empty());
+}
+
+TEST_CASE("changes to entries since removed are dropped", "[ResolutionRevalidator]") {
+  ResolvedPathCache cache;
+  cache.insert("bal:///cat", kContextHash, ArResolvedPath{"/v1/cat.usd"});
+  ResolutionRevalidator revalidator{
+      cache, kNeverInterval,
+      [](const std::string & /*assetPath*/, const ArResolverContext & /*context*/,
+         ArResolvedPath &resolvedPath) {
+        resolvedPath = ArResolvedPath{"/v2/cat.usd"};
+        return true;
+      }};
+  revalidator.addContext(kContextHash,
+                         ArResolverContext{ArDefaultResolverContext{{"/search"}}});
+  REQUIRE(revalidator.check() == 1);
+
+  // When the cache is cleared, e.g. by a context refresh, before the
+  // change is applied
+  cache.clear();
+
+  // Then the change is not applied
+  CHECK(revalidator.apply().empty());
+  ArResolvedPath cached;
+  CHECK(!cache.find("bal:///cat", kContextHash, cached));
+}
+
+TEST_CASE("changes to entries resolved afresh since checked are dropped",
+          "[ResolutionRevalidator]") {
+  ResolvedPathCache cache;
+  cache.insert("bal:///cat", kContextHash, ArResolvedPath{"/v1/cat.usd"});
+  ResolutionRevalidator revalidator{
+      cache, kNeverInterval,
+      [](const std::string & /*assetPath*/, const ArResolverContext & /*context*/,
+         ArResolvedPath &resolvedPath) {
+        resolvedPath = ArResolvedPath{"/v2/cat.usd"};
+        return true;
+      }};
+  revalidator.addContext(kContextHash,
+                         ArResolverContext{ArDefaultResolverContext{{"/search"}}});
+  REQUIRE(revalidator.check() == 1);
+
+  // When the entry is resolved afresh, to a newer resolution, before
+  // the change is applied
+  cache.insert("bal:///cat", kContextHash, ArResolvedPath{"/v3/cat.usd"});
+
+  // Then the change is not applied over the newer resolution
+  CHECK(revalidator.apply().empty());
+  ArResolvedPath cached;
+  REQUIRE(cache.find("bal:///cat", kContextHash, cached));
+  CHECK(cached.GetPathString() == "/v3/cat.usd");
+}
+
+TEST_CASE("discarded changes are not applied", "[ResolutionRevalidator]") {
+  ResolvedPathCache cache;
+  cache.insert("bal:///cat", kContextHash, ArResolvedPath{"/v1/cat.usd"});
+  ResolutionRevalidator revalidator{
+      cache, kNeverInterval,
+      [](const std::string & /*assetPath*/, const ArResolverContext & /*context*/,
+         ArResolvedPath &resolvedPath) {
+        resolvedPath = ArResolvedPath{"/v2/cat.usd"};
+        return true;
+      }};
+  revalidator.addContext(kContextHash,
+                         ArResolverContext{ArDefaultResolverContext{{"/search"}}});
+  REQUIRE(revalidator.check() == 1);
+
+  // When the changes held back are discarded, e.g. on a context
+  // refresh
+  revalidator.discard();
+
+  // Then the cache is left as it is
+  CHECK(revalidator.apply().empty());
+  ArResolvedPath cached;
+  REQUIRE(cache.find("bal:///cat", kContextHash, cached));
+  CHECK(cached.GetPathString() == "/v1/cat.usd");
+}
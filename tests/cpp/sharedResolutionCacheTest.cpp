@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "sharedResolutionCache.h"
+
+// Build with -fsanitize=address or -fsanitize=thread (see README) to
+// check the lock-free publishing as well as the values read back.
+
+namespace {
+constexpr std::size_t kSegmentBytes = std::size_t{16} << 20U;
+constexpr std::size_t kProcessCount = 4;
+constexpr std::size_t kThreadCount = 4;
+// Few enough to fit the segment, so that every key is published.
+constexpr std::size_t kKeyCount = 2000;
+constexpr std::size_t kContextCount = 3;
+
+std::string assetPath(const std::size_t idx) { return "bal:///asset/" + std::to_string(idx); }
+
+std::size_t contextHash(const std::size_t idx) { return idx % kContextCount + 1; }
+
+std::string resolvedPath(const std::size_t idx) {
+  return "/show/assets/" + std::to_string(idx) + "/v" + std::to_string(contextHash(idx)) +
+         "/geo.usd";
+}
+
+// A segment name unique to this process, unlinked when done with.
+class Segment {
+ public:
+  explicit Segment(const std::string &test)
+      : name_{"usdOpenAssetIOResolverTest" + test + std::to_string(::getpid())} {
+    SharedResolutionCache::unlink(name_);
+  }
+  ~Segment() { SharedResolutionCache::unlink(name_); }
+
+  Segment(const Segment &) = delete;
+  Segment &operator=(const Segment &) = delete;
+
+  [[nodiscard]] std::unique_ptr<SharedResolutionCache> open() const {
+    return SharedResolutionCache::open(name_, kSegmentBytes);
+  }
+
+ private:
+  std::string name_;
+};
+
+// Look up every key, in an order particular to the worker, publishing
+// those not yet found. Returns whether every value found was intact.
+bool findOrPublishAll(SharedResolutionCache &cache, const std::size_t worker) {
+  bool intact = true;
+  for (std::size_t step = 0; step < kKeyCount; ++step) {
+    const std::size_t idx = (step * (2 * worker + 1) + worker) % kKeyCount;
+    std::string_view found;
+    if (cache.findResolution(assetPath(idx), contextHash(idx), found)) {
+      intact = intact && found == resolvedPath(idx);
+    } else {
+      cache.publishResolution(assetPath(idx), contextHash(idx), resolvedPath(idx));
+    }
+  }
+  return intact;
+}
+
+// Whether every key is found, with its value intact.
+bool findAll(const SharedResolutionCache &cache) {
+  for (std::size_t idx = 0; idx < kKeyCount; ++idx) {
+    std::string_view found;
+    if (!cache.findResolution(assetPath(idx), contextHash(idx), found) ||
+        found != resolvedPath(idx)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Race threads over their own mappings of the segment, as if each were
+// a process of its own.
+bool raceThreads(const Segment &segment, const std::size_t firstWorker) {
+  std::vector<std::unique_ptr<SharedResolutionCache>> caches;
+  for (std::size_t idx = 0; idx < kThreadCount; ++idx) {
+    caches.push_back(segment.open());
+    if (!caches.back()) {
+      return false;
+    }
+  }
+  std::vector<char> intact(kThreadCount, 0);
+  std::vector<std::thread> threads;
+  for (std::size_t idx = 0; idx < kThreadCount; ++idx) {
+    threads.emplace_back([&caches, &intact, idx, firstWorker] {
+      intact[idx] = findOrPublishAll(*caches[idx], firstWorker + idx) ? 1 : 0;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  for (std::size_t idx = 0; idx < kThreadCount; ++idx) {
+    if (intact[idx] == 0 || !findAll(*caches[idx])) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+TEST_CASE("threads publishing concurrently each read back intact resolutions",
+          "[SharedResolutionCache]") {
+  const Segment segment{"Threads"};
+
+  // When threads with their own mappings of a segment race to find or
+  // publish the same resolutions
+  const bool intact = raceThreads(segment, 0);
+
+  // Then every value read back, mid-race and after, is as published,
+  // though threads publishing a key at once may each claim a slot
+  CHECK(intact);
+  const auto cache = segment.open();
+  REQUIRE(cache);
+  CHECK(cache->stats().entries >= kKeyCount);
+}
+
+TEST_CASE("processes publishing concurrently each read back intact resolutions",
+          "[SharedResolutionCache]") {
+  const Segment segment{"Processes"};
+
+  // When processes, each with several threads, race to find or publish
+  // the same resolutions
+  std::vector<pid_t> children;
+  for (std::size_t idx = 0; idx < kProcessCount; ++idx) {
+    const pid_t pid = ::fork();
+    REQUIRE(pid >= 0);
+    if (pid == 0) {
+      ::_exit(raceThreads(segment, idx * kThreadCount) ? EXIT_SUCCESS : EXIT_FAILURE);
+    }
+    children.push_back(pid);
+  }
+
+  // Then every value read back in every process is as published
+  for (const pid_t pid : children) {
+    int status = 0;
+    REQUIRE(::waitpid(pid, &status, 0) == pid);
+    CHECK(WIFEXITED(status));
+    CHECK(WEXITSTATUS(status) == EXIT_SUCCESS);
+  }
+  const auto cache = segment.open();
+  REQUIRE(cache);
+  CHECK(findAll(*cache));
+}
+
+TEST_CASE("invalidated resolutions are not found by any mapping", "[SharedResolutionCache]") {
+  const Segment segment{"Invalidate"};
+  const auto cache = segment.open();
+  const auto other = segment.open();
+  REQUIRE(cache);
+  REQUIRE(other);
+  cache->publishResolution("bal:///cat", 1, "/v1/cat.usd");
+  std::string_view found;
+  REQUIRE(other->findResolution("bal:///cat", 1, found));
+
+  // When resolutions are invalidated through one mapping
+  cache->invalidateResolutions();
+
+  // Then neither mapping finds them, but both find those published
+  // since
+  CHECK(!cache->findResolution("bal:///cat", 1, found));
+  CHECK(!other->findResolution("bal:///cat", 1, found));
+  other->publishResolution("bal:///cat", 1, "/v2/cat.usd");
+  REQUIRE(cache->findResolution("bal:///cat", 1, found));
+  CHECK(found == "/v2/cat.usd");
+}
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "budgetedCache.h"
+#include "singleFlight.h"
+
+namespace {
+using ResolveFlight = SingleFlight<ResolveKey, std::string, ResolveKey::Hash>;
+
+constexpr std::size_t kFollowerCount = 8;
+constexpr std::size_t kContextHash = 1;
+constexpr std::size_t kOtherContextHash = 2;
+
+// A computation that blocks until released, so that it is in flight
+// whilst other callers arrive.
+class Gate {
+ public:
+  void wait() {
+    entered_.set_value();
+    released_.get_future().wait();
+  }
+  void waitUntilEntered() { entered_.get_future().wait(); }
+  void release() { released_.set_value(); }
+
+ private:
+  std::promise<void> entered_;
+  std::promise<void> released_;
+};
+}  // namespace
+
+TEST_CASE("concurrent runs of the same key are coalesced", "[SingleFlight]") {
+  ResolveFlight flight;
+  const ResolveKey key{"bal:///cat", kContextHash};
+  Gate gate;
+  std::atomic<bool> leaderDone{false};
+  std::atomic<std::size_t> computedInFlight{0};
+
+  // Given a computation in flight for a key
+  auto leader = std::async(std::launch::async, [&] {
+    return flight.run(key, [&] {
+      gate.wait();
+      leaderDone = true;
+      return std::string{"/leader/cat.usd"};
+    });
+  });
+  gate.waitUntilEntered();
+
+  // When further runs of the key arrive whilst it is in flight
+  std::vector<std::future<std::string>> followers;
+  for (std::size_t idx = 0; idx < kFollowerCount; ++idx) {
+    followers.push_back(std::async(std::launch::async, [&] {
+      return flight.run(key, [&] {
+        if (!leaderDone) {
+          ++computedInFlight;
+        }
+        return std::string{"/follower/cat.usd"};
+      });
+    }));
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds{50});
+  gate.release();
+
+  // Then none compute the key again whilst it is in flight, and those
+  // that arrived in time share its result
+  CHECK(leader.get() == "/leader/cat.usd");
+  std::size_t sharedCount = 0;
+  for (auto &follower : followers) {
+    if (follower.get() == "/leader/cat.usd") {
+      ++sharedCount;
+    }
+  }
+  CHECK(computedInFlight == 0);
+  CHECK(sharedCount > 0);
+}
+
+TEST_CASE("runs of the same path in different contexts are not coalesced", "[SingleFlight]") {
+  ResolveFlight flight;
+  Gate gate;
+
+  // Given a computation in flight for a path in one context
+  auto leader = std::async(std::launch::async, [&] {
+    return flight.run(ResolveKey{"bal:///cat", kContextHash}, [&] {
+      gate.wait();
+      return std::string{"/context1/cat.usd"};
+    });
+  });
+  gate.waitUntilEntered();
+
+  // When the same path is run in another context
+  const std::string other = flight.run(ResolveKey{"bal:///cat", kOtherContextHash},
+                                       [] { return std::string{"/context2/cat.usd"}; });
+  gate.release();
+
+  // Then it is computed in that context, without waiting
+  CHECK(other == "/context2/cat.usd");
+  CHECK(leader.get() == "/context1/cat.usd");
+}
+
+TEST_CASE("completed computations are not retained", "[SingleFlight]") {
+  ResolveFlight flight;
+  const ResolveKey key{"bal:///cat", kContextHash};
+  std::size_t computeCount = 0;
+
+  // When a key is run twice in turn
+  for (std::size_t idx = 0; idx < 2; ++idx) {
+    (void)flight.run(key, [&] {
+      ++computeCount;
+      return std::string{"/cat.usd"};
+    });
+  }
+
+  // Then it is computed each time
+  CHECK(computeCount == 2);
+}
@@ -0,0 +1,130 @@
+# SPDX-License-Identifier: Apache-2.0
+# Copyright 2023 The Foundry Visionmongers Ltd
+
+# pylint: disable=missing-function-docstring,missing-module-docstring
+
+# Utility functions shared by the tests. Most configure the resolver
+# from the environment, so open scenes in a fresh process.
+
+import ctypes
+import os
+import subprocess
+import sys
+
+import pytest
+from pxr import Plug
+
+
+# The entity references in the recursive assetized scene, and the
+# files they resolve to.
+def recursive_assetized_resolutions():
+    scene_dir = resource_path("resources/integration_test_data/recursive_assetized_resolve")
+    return {
+        "bal:///floor": os.path.join(scene_dir, "floors", "floor1.usd"),
+        "bal:///car": os.path.join(scene_dir, "cars", "car.usd"),
+    }
+
+
+def recursive_assetized_stage_path():
+    return resource_path(
+        "resources/integration_test_data/recursive_assetized_resolve/parking_lot.usd"
+    )
+
+
+# Open the scene in a fresh process, so that the resolver is
+# configured from the given environment, returning whether the
+# assetized car references were resolved.
+def open_recursive_assetized_scene(**settings):
+    script = (
+        "from pxr import Usd\n"
+        f"stage = Usd.Stage.Open({recursive_assetized_stage_path()!r})\n"
+        "car = stage.GetPrimAtPath('/ParkingLot/ParkingLot_Floor_1/Car1')\n"
+        "print(car.IsValid() and car.GetPropertyNames() == ['color'])\n"
+    )
+    result = run_in_fresh_process(script, **settings)
+    return result.stdout.strip().splitlines()[-1] == "True"
+
+
+# The environment for a fresh process, with the given settings, where
+# None unsets a setting. Debug output is disabled unless set, so as not
+# to mix with the output checked.
+def fresh_environment(**settings):
+    env = dict(os.environ)
+    env.pop("TF_DEBUG", None)
+    for name, value in settings.items():
+        if value is None:
+            env.pop(name, None)
+        else:
+            env[name] = value
+    return env
+
+
+# Run a Python script in a fresh process, so that the resolver is
+# configured from the given settings, returning the completed process.
+def run_in_fresh_process(script, **settings):
+    return subprocess.run(
+        [sys.executable, "-c", script],
+        env=fresh_environment(**settings),
+        check=True,
+        capture_output=True,
+        text=True,
+    )
+
+
+# Run a tool, installed alongside the plugin, configured as by
+# run_in_fresh_process.
+def run_tool(name, *args, **settings):
+    return subprocess.run(
+        [tool_executable(name), *(str(arg) for arg in args)],
+        env=fresh_environment(**settings),
+        check=True,
+        capture_output=True,
+        text=True,
+    )
+
+
+# Write a resolution manifest through the plugin's entry point. Version
+# pins files are resolution manifests too.
+def write_manifest(path, resolutions):
+    plugin = Plug.Registry().GetPluginWithName("usdOpenAssetIOResolver")
+    lib = ctypes.CDLL(plugin.path)
+    lib.UsdOpenAssetIOResolverWriteManifestEntries.argtypes = [
+        ctypes.c_char_p,
+        ctypes.c_size_t,
+        ctypes.POINTER(ctypes.c_char_p),
+        ctypes.POINTER(ctypes.c_char_p),
+    ]
+    asset_paths = (ctypes.c_char_p * len(resolutions))(*(key.encode() for key in resolutions))
+    resolved_paths = (ctypes.c_char_p * len(resolutions))(
+        *(value.encode() for value in resolutions.values())
+    )
+    assert lib.UsdOpenAssetIOResolverWriteManifestEntries(
+        str(path).encode(), len(resolutions), asset_paths, resolved_paths
+    )
+
+
+# Create a search path directory in which the default resolver will
+# find the given entity reference, e.g. "bal:///cat.usda", until a
+# manager is hosted, returning the directory.
+def write_search_path_entity(search_path, name, exist_ok=False):
+    entity_dir = search_path / "bal:"
+    entity_dir.mkdir(parents=True, exist_ok=exist_ok)
+    (entity_dir / name).write_text("#usda 1.0\n")
+    return str(search_path)
+
+
+# Locate a tool, installed alongside the plugin, skipping the test if
+# it was not built.
+def tool_executable(name):
+    plugin_path = os.environ.get("PXR_PLUGINPATH_NAME", "")
+    install_root = os.path.dirname(os.path.dirname(plugin_path))
+    tool = os.path.join(install_root, "bin", name)
+    if not os.path.isfile(tool):
+        pytest.skip(f"{name} not built")
+    return tool
+
+
+# Get the absolute path to a file relative to the tests directory.
+def resource_path(path_relative_from_file):
+    script_dir = os.path.realpath(os.path.dirname(__file__))
+    return os.path.join(script_dir, path_relative_from_file)
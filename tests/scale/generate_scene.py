@@ -0,0 +1,175 @@
+# SPDX-License-Identifier: Apache-2.0
+# Copyright 2023 The Foundry Visionmongers Ltd
+"""
+Generates parking_lot-style scenes at configurable scale, for scale
+testing the resolver.
+
+The root layer, parking_lot.usd, contains the requested number of
+prims, grouped under /ParkingLot, each referencing one of the
+requested number of unique entities. Entities are arranged in
+`reference_depth` levels, each entity in one level referencing
+`reference_fanout` entities in the next, so that composition must
+resolve references recursively.
+
+By default references are authored as entity references, along with a
+matching bal_library.json for the BasicAssetLibrary manager. Plain
+relative file path references can be authored instead, for comparison.
+"""
+
+import argparse
+import json
+import os
+import pathlib
+
+# Number of referencing prims under each group prim in the root layer.
+GROUP_SIZE = 1000
+
+
+def entity_name(index):
+    return f"entity_{index}"
+
+
+def level_sizes(num_entities, reference_depth):
+    """
+    Split the entities evenly between levels, the first level taking
+    any remainder.
+    """
+    size, remainder = divmod(num_entities, reference_depth)
+    if size == 0:
+        raise ValueError("Need at least as many entities as reference levels")
+    return [size + remainder] + [size] * (reference_depth - 1)
+
+
+def generate_scene(
+    output_dir,
+    num_prims,
+    num_entities,
+    reference_depth=1,
+    reference_fanout=1,
+    entity_prefix="bal:///",
+    file_references=False,
+):
+    """
+    Generate a scene, returning the path to its root layer.
+    """
+    output_dir = pathlib.Path(output_dir).resolve()
+    entities_dir = output_dir / "entities"
+    entities_dir.mkdir(parents=True, exist_ok=True)
+
+    sizes = level_sizes(num_entities, reference_depth)
+    level_offsets = [sum(sizes[:level]) for level in range(reference_depth)]
+
+    def reference(index, from_root):
+        if file_references:
+            relative_dir = "./entities/" if from_root else "./"
+            return f"@{relative_dir}{entity_name(index)}.usd@"
+        return f"@{entity_prefix}{entity_name(index)}@"
+
+    # Entities, each referencing `reference_fanout` entities in the
+    # next level down.
+    for level in range(reference_depth):
+        for local_index in range(sizes[level]):
+            index = level_offsets[level] + local_index
+            lines = [
+                "#usda 1.0",
+                '(\n    defaultPrim = "Entity"\n)',
+                "",
+                'def "Entity"',
+                "{",
+                f"    color3f color = ({index % 7 / 7}, {index % 11 / 11}, {index % 13 / 13})",
+            ]
+            if level + 1 < reference_depth:
+                for child in range(reference_fanout):
+                    child_index = level_offsets[level + 1] + (
+                        (local_index * reference_fanout + child) % sizes[level + 1]
+                    )
+                    lines.append(
+                        f'    def "Child_{child}" (\n'
+                        f"        references = {reference(child_index, False)}\n"
+                        "    )\n    {\n    }"
+                    )
+            lines.append("}\n")
+            (entities_dir / f"{entity_name(index)}.usd").write_text("\n".join(lines))
+
+    # Root layer, referencing the top level of entities round-robin.
+    root_layer = output_dir / "parking_lot.usd"
+    with root_layer.open("w") as root:
+        root.write('#usda 1.0\n(\n    defaultPrim = "ParkingLot"\n)\n\ndef "ParkingLot"\n{\n')
+        for group_start in range(0, num_prims, GROUP_SIZE):
+            root.write(f'    def "Group_{group_start // GROUP_SIZE}"\n    {{\n')
+            for prim in range(group_start, min(group_start + GROUP_SIZE, num_prims)):
+                root.write(
+                    f'        def "Car_{prim}" (\n'
+                    f"            references = {reference(prim % sizes[0], True)}\n"
+                    "        )\n        {\n        }\n"
+                )
+            root.write("    }\n")
+        root.write("}\n")
+
+    # Library for the BasicAssetLibrary manager, mapping each entity to
+    # its generated layer.
+    library = {
+        "entities": {
+            entity_name(index): {
+                "versions": [
+                    {
+                        "traits": {
+                            "openassetio-mediacreation:content.LocatableContent": {
+                                "location": (entities_dir / f"{entity_name(index)}.usd").as_uri()
+                            }
+                        }
+                    }
+                ]
+            }
+            for index in range(num_entities)
+        }
+    }
+    (output_dir / "bal_library.json").write_text(json.dumps(library, indent=2))
+
+    return str(root_layer)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("output_dir", help="Directory to write the scene to")
+    parser.add_argument(
+        "--prims", type=int, default=10_000, help="Number of referencing prims in the root layer"
+    )
+    parser.add_argument(
+        "--entities", type=int, default=1_000, help="Number of unique referenced entities"
+    )
+    parser.add_argument(
+        "--reference-depth", type=int, default=1, help="Number of levels of nested references"
+    )
+    parser.add_argument(
+        "--reference-fanout",
+        type=int,
+        default=1,
+        help="Number of references from each entity to entities in the next level",
+    )
+    parser.add_argument(
+        "--entity-prefix",
+        default=os.environ.get("OPENASSETIO_RESOLVER_ENTITY_REFERENCE_PREFIX", "bal:///"),
+        help="Prefix of authored entity references",
+    )
+    parser.add_argument(
+        "--file-references",
+        action="store_true",
+        help="Author relative file path references rather than entity references",
+    )
+    args = parser.parse_args()
+
+    root_layer = generate_scene(
+        args.output_dir,
+        args.prims,
+        args.entities,
+        args.reference_depth,
+        args.reference_fanout,
+        args.entity_prefix,
+        args.file_references,
+    )
+    print(root_layer)
+
+
+if __name__ == "__main__":
+    main()
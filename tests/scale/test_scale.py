@@ -0,0 +1,127 @@
+# SPDX-License-Identifier: Apache-2.0
+# Copyright 2023 The Foundry Visionmongers Ltd
+"""
+Scale benchmarks of stage open through the resolver, using generated
+parking_lot-style scenes.
+
+Skipped unless OPENASSETIO_RESOLVER_SCALE_TESTS is set. Set it to
+"full" to include the largest (1M prim) scenes. Run with e.g.
+
+    OPENASSETIO_RESOLVER_SCALE_TESTS=1 pytest scale --benchmark-only
+"""
+
+# pylint: disable=missing-function-docstring,redefined-outer-name
+
+import json
+import os
+import subprocess
+import sys
+
+import pytest
+
+from generate_scene import generate_scene
+
+SCALE_TESTS = os.environ.get("OPENASSETIO_RESOLVER_SCALE_TESTS", "")
+
+pytestmark = pytest.mark.skipif(
+    not SCALE_TESTS, reason="OPENASSETIO_RESOLVER_SCALE_TESTS not set"
+)
+
+only_full = pytest.mark.skipif(
+    SCALE_TESTS != "full", reason='OPENASSETIO_RESOLVER_SCALE_TESTS is not "full"'
+)
+
+# Opens a stage in a fresh process, so that peak RSS and resolver calls
+# are isolated to the one stage open.
+OPEN_STAGE_SCRIPT = """
+import json, resource, sys, time
+from pxr import Usd
+start = time.perf_counter()
+stage = Usd.Stage.Open(sys.argv[1])
+elapsed = time.perf_counter() - start
+print(json.dumps({
+    "open_seconds": elapsed,
+    "prims": sum(1 for _ in stage.Traverse()),
+    "peak_rss_kb": resource.getrusage(resource.RUSAGE_SELF).ru_maxrss,
+}))
+"""
+
+
+@pytest.mark.parametrize(
+    "num_prims,num_entities,reference_depth,reference_fanout",
+    [
+        (10_000, 1_000, 1, 1),
+        (10_000, 1_000, 3, 4),
+        (100_000, 10_000, 1, 1),
+        (100_000, 10_000, 3, 4),
+        pytest.param(1_000_000, 100_000, 1, 1, marks=only_full),
+        pytest.param(1_000_000, 100_000, 3, 4, marks=only_full),
+    ],
+)
+@pytest.mark.parametrize("file_references", [False, True], ids=["entity_refs", "file_refs"])
+def test_stage_open_at_scale(
+    benchmark,
+    tmp_path_factory,
+    num_prims,
+    num_entities,
+    reference_depth,
+    reference_fanout,
+    file_references,
+):
+    scene_dir = tmp_path_factory.mktemp("scene")
+    root_layer = generate_scene(
+        scene_dir,
+        num_prims,
+        num_entities,
+        reference_depth,
+        reference_fanout,
+        file_references=file_references,
+    )
+
+    # Timed with no instrumentation, which would otherwise be measured
+    # too.
+    def open_stage():
+        return open_stage_in_fresh_process(root_layer)
+
+    stats = benchmark.pedantic(open_stage, rounds=3, iterations=1)
+
+    benchmark.extra_info.update(stats)
+    benchmark.extra_info["resolver_calls"] = count_resolver_calls(
+        root_layer, scene_dir / "calls.json"
+    )
+
+    assert stats["prims"] >= num_prims
+
+
+##### Utility Functions #####
+
+
+# Open the stage with the given settings, and no instrumentation
+# inherited from the environment.
+def open_stage_in_fresh_process(root_layer, **settings):
+    env = dict(os.environ)
+    for name in ("TF_DEBUG", "OPENASSETIO_RESOLVER_TRACE_FILE", "OPENASSETIO_RESOLVER_CALL_STATS"):
+        env.pop(name, None)
+    env.update(settings)
+    result = subprocess.run(
+        [sys.executable, "-c", OPEN_STAGE_SCRIPT, root_layer],
+        env=env,
+        check=True,
+        capture_output=True,
+        text=True,
+    )
+    return json.loads(result.stdout.splitlines()[-1])
+
+
+def count_resolver_calls(root_layer, stats_file):
+    """
+    Count the calls per resolver method in a separate, untimed, stage
+    open, from the call stats written by the resolver.
+    """
+    open_stage_in_fresh_process(
+        root_layer,
+        OPENASSETIO_RESOLVER_CALL_STATS="1",
+        OPENASSETIO_RESOLVER_CALL_STATS_FILE=str(stats_file),
+    )
+    with open(stats_file, encoding="utf-8") as file:
+        return {method: stats["count"] for method, stats in json.load(file).items()}
@@ -0,0 +1,56 @@
+# SPDX-License-Identifier: Apache-2.0
+# Copyright 2023 The Foundry Visionmongers Ltd
+
+# pylint: disable=missing-function-docstring,missing-module-docstring
+
+from resolver_test_utils import resource_path, run_in_fresh_process, run_tool
+
+
+# Given a trace file is configured, when a stage is opened, then every
+# resolver call is recorded to the trace, and the trace can be replayed
+# against a fresh resolver giving the same results.
+def test_call_trace_recorded_and_replayed(tmp_path):
+    trace_file = tmp_path / "stage.trace"
+    stage_path = resource_path(
+        "resources/integration_test_data/resolver_has_no_effect_with_no_search_path/parking_lot.usd"
+    )
+
+    run_in_fresh_process(
+        f"from pxr import Usd; Usd.Stage.Open({stage_path!r})",
+        OPENASSETIO_RESOLVER_TRACE_FILE=str(trace_file),
+    )
+
+    assert trace_file.read_bytes().startswith(b"OAIOTRC1")
+
+    result = run_tool("usdOpenAssetIOResolverReplay", trace_file)
+
+    methods = {line.split()[0]: line.split()[1:] for line in result.stdout.splitlines()[3:]}
+    for method in ("_CreateIdentifier", "_Resolve", "_OpenAsset"):
+        assert int(methods[method][0]) > 0
+        # No mismatches against the recorded results.
+        assert methods[method][-1] == "0"
+
+
+# Given a trace recorded whilst a search path context was bound, when
+# the trace is replayed, then resolves dependent on the search path
+# give the same results.
+def test_call_trace_replayed_in_recorded_context(tmp_path):
+    trace_file = tmp_path / "context.trace"
+    search_path = tmp_path / "search"
+    (search_path / "bal:").mkdir(parents=True)
+    (search_path / "bal:" / "cat.usda").write_text("#usda 1.0\n")
+    script = (
+        "from pxr import Ar\n"
+        f"context = Ar.ResolverContext(Ar.DefaultResolverContext([{str(search_path)!r}]))\n"
+        "with Ar.ResolverContextBinder(context):\n"
+        "    assert Ar.GetResolver().Resolve('bal:///cat.usda')\n"
+    )
+
+    run_in_fresh_process(script, OPENASSETIO_RESOLVER_TRACE_FILE=str(trace_file))
+
+    result = run_tool("usdOpenAssetIOResolverReplay", trace_file)
+
+    methods = {line.split()[0]: line.split()[1:] for line in result.stdout.splitlines()[3:]}
+    assert int(methods["_BindContext"][0]) == 1
+    assert int(methods["_Resolve"][0]) > 0
+    assert methods["_Resolve"][-1] == "0"
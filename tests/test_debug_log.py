@@ -0,0 +1,42 @@
+# SPDX-License-Identifier: Apache-2.0
+# Copyright 2023 The Foundry Visionmongers Ltd
+
+# pylint: disable=missing-function-docstring,missing-module-docstring
+
+from resolver_test_utils import resource_path, run_in_fresh_process
+
+
+# Given asynchronous logging is enabled, when a stage is opened, then
+# the same debug records are written as when logging synchronously.
+def test_async_logging_writes_same_records_as_sync():
+    sync_records = open_stage_and_capture_records()
+    async_records = open_stage_and_capture_records(OPENASSETIO_RESOLVER_LOG_ASYNC="1")
+
+    assert sorted(async_records) == sorted(sync_records)
+
+
+# Given log sampling is configured, when a stage is opened, then only
+# a fraction of the debug records are written.
+def test_log_sampling_reduces_records():
+    all_records = open_stage_and_capture_records()
+    sampled_records = open_stage_and_capture_records(OPENASSETIO_RESOLVER_LOG_SAMPLE="4")
+
+    assert 0 < len(sampled_records) < len(all_records)
+
+
+##### Utility Functions #####
+
+
+def open_stage_and_capture_records(**settings):
+    stage_path = resource_path(
+        "resources/integration_test_data/resolver_has_no_effect_with_no_search_path/parking_lot.usd"
+    )
+    result = run_in_fresh_process(
+        f"from pxr import Usd; Usd.Stage.Open({stage_path!r})",
+        TF_DEBUG="OPENASSETIO_RESOLVER",
+        **settings,
+    )
+    return [
+        "OPENASSETIO_RESOLVER: " + record
+        for record in result.stdout.split("OPENASSETIO_RESOLVER: ")[1:]
+    ]
@@ -0,0 +1,90 @@
+# SPDX-License-Identifier: Apache-2.0
+# Copyright 2023 The Foundry Visionmongers Ltd
+
+# pylint: disable=missing-function-docstring,missing-module-docstring
+
+from resolver_test_utils import (
+    open_recursive_assetized_scene,
+    recursive_assetized_resolutions,
+    recursive_assetized_stage_path,
+    run_tool,
+    write_manifest,
+)
+
+
+# Given a resolution manifest mapping the entity references in an
+# assetized scene to files, when the scene is opened with the manifest
+# configured, then the scene is fully resolved.
+def test_assetized_scene_resolved_from_manifest(tmp_path):
+    manifest = tmp_path / "shot.manifest"
+    write_manifest(manifest, recursive_assetized_resolutions())
+
+    assert open_recursive_assetized_scene(OPENASSETIO_RESOLVER_MANIFEST=str(manifest))
+
+
+# Given manifest export is configured, when an assetized scene is
+# opened, then the exported manifest alone is enough to open the scene
+# again.
+def test_exported_manifest_resolves_scene(tmp_path):
+    source_manifest = tmp_path / "source.manifest"
+    exported_manifest = tmp_path / "exported.manifest"
+    write_manifest(source_manifest, recursive_assetized_resolutions())
+
+    assert open_recursive_assetized_scene(
+        OPENASSETIO_RESOLVER_MANIFEST=str(source_manifest),
+        OPENASSETIO_RESOLVER_MANIFEST_EXPORT=str(exported_manifest),
+    )
+    assert open_recursive_assetized_scene(OPENASSETIO_RESOLVER_MANIFEST=str(exported_manifest))
+
+
+# Given a resolution manifest, when an entity reference not in the
+# manifest is opened, then it is resolved as if there were no manifest.
+def test_entity_reference_not_in_manifest_falls_through(tmp_path):
+    manifest = tmp_path / "empty.manifest"
+    write_manifest(manifest, {})
+
+    assert not open_recursive_assetized_scene(OPENASSETIO_RESOLVER_MANIFEST=str(manifest))
+
+
+# Given a stage whose entity references can be resolved, when the
+# manifest tool is run on its root layer, then the manifest written is
+# enough to open the scene.
+def test_manifest_tool_writes_manifest_resolving_scene(tmp_path):
+    source_manifest = tmp_path / "source.manifest"
+    authored_manifest = tmp_path / "authored.manifest"
+    write_manifest(source_manifest, recursive_assetized_resolutions())
+
+    result = run_tool(
+        "usdOpenAssetIOResolverManifest",
+        "--threads",
+        "4",
+        recursive_assetized_stage_path(),
+        authored_manifest,
+        OPENASSETIO_RESOLVER_MANIFEST=str(source_manifest),
+    )
+
+    assert result.stdout.startswith("Wrote 2 entity reference resolutions from 3 layers")
+    assert open_recursive_assetized_scene(OPENASSETIO_RESOLVER_MANIFEST=str(authored_manifest))
+
+
+# Given an entity reference found in several layers, when the manifest
+# tool is run, then it is written and counted once.
+def test_manifest_tool_writes_each_entity_reference_once(tmp_path):
+    source_manifest = tmp_path / "source.manifest"
+    authored_manifest = tmp_path / "authored.manifest"
+    write_manifest(source_manifest, recursive_assetized_resolutions())
+    root_layer = tmp_path / "root.usda"
+    root_layer.write_text('#usda 1.0\n(\n    subLayers = [@./a.usda@, @./b.usda@]\n)\n')
+    for name in ("a", "b"):
+        (tmp_path / f"{name}.usda").write_text(
+            f'#usda 1.0\n\ndef "{name}" (\n    references = @bal:///car@</Car>\n)\n{{\n}}\n'
+        )
+
+    result = run_tool(
+        "usdOpenAssetIOResolverManifest",
+        root_layer,
+        authored_manifest,
+        OPENASSETIO_RESOLVER_MANIFEST=str(source_manifest),
+    )
+
+    assert result.stdout.startswith("Wrote 1 entity reference resolutions from 4 layers")
@@ -0,0 +1,78 @@
+# SPDX-License-Identifier: Apache-2.0
+# Copyright 2023 The Foundry Visionmongers Ltd
+
+# pylint: disable=missing-function-docstring,missing-module-docstring
+
+import contextlib
+import subprocess
+
+from resolver_test_utils import (
+    fresh_environment,
+    open_recursive_assetized_scene,
+    recursive_assetized_resolutions,
+    run_in_fresh_process,
+    tool_executable,
+    write_manifest,
+)
+
+
+# Given a resolve daemon that can resolve the entity references in an
+# assetized scene, when the scene is opened by a client of the daemon
+# with no manifest of its own, then the scene is fully resolved.
+def test_scene_resolved_through_daemon(tmp_path):
+    manifest = tmp_path / "shot.manifest"
+    socket_path = tmp_path / "resolver.sock"
+    write_manifest(manifest, recursive_assetized_resolutions())
+
+    with running_daemon(socket_path, OPENASSETIO_RESOLVER_MANIFEST=str(manifest)):
+        assert open_recursive_assetized_scene(OPENASSETIO_RESOLVER_DAEMON_SOCKET=str(socket_path))
+
+    assert not socket_path.exists()
+
+
+# Given a resolve daemon, when a client resolves an entity reference
+# found via the search path of its bound context, then the daemon
+# resolves it in that context.
+def test_entity_reference_resolved_through_daemon_in_client_context(tmp_path):
+    manifest = tmp_path / "daemon.manifest"
+    socket_path = tmp_path / "resolver.sock"
+    search_path = tmp_path / "search"
+    (search_path / "bal:").mkdir(parents=True)
+    (search_path / "bal:" / "cat.usda").write_text("#usda 1.0\n")
+    # Known only to the daemon, to show that it is the daemon resolving.
+    dog_path = str(tmp_path / "dog.usda")
+    (tmp_path / "dog.usda").write_text("#usda 1.0\n")
+    write_manifest(manifest, {"bal:///dog.usda": dog_path})
+    script = (
+        "from pxr import Ar\n"
+        "resolver = Ar.GetResolver()\n"
+        f"context = Ar.ResolverContext(Ar.DefaultResolverContext([{str(search_path)!r}]))\n"
+        "with Ar.ResolverContextBinder(context):\n"
+        "    print(resolver.Resolve('bal:///dog.usda').GetPathString())\n"
+        "    print(resolver.Resolve('bal:///cat.usda').GetPathString())\n"
+    )
+
+    with running_daemon(socket_path, OPENASSETIO_RESOLVER_MANIFEST=str(manifest)):
+        result = run_in_fresh_process(script, OPENASSETIO_RESOLVER_DAEMON_SOCKET=str(socket_path))
+
+    assert result.stdout.split() == [dog_path, str(search_path / "bal:" / "cat.usda")]
+
+
+##### Utility Functions #####
+
+
+# Run the resolve daemon, configured from the given environment, for
+# the duration of the context.
+@contextlib.contextmanager
+def running_daemon(socket_path, **settings):
+    with subprocess.Popen(
+        [tool_executable("usdOpenAssetIOResolverDaemon"), str(socket_path)],
+        env=fresh_environment(**settings),
+        stdout=subprocess.PIPE,
+        text=True,
+    ) as daemon:
+        try:
+            assert daemon.stdout.readline().startswith("Listening on")
+            yield daemon
+        finally:
+            daemon.terminate()
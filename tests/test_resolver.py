@@ -5,13 +5,18 @@
 # pylint: disable=wrong-import-position,unused-import
 # pylint: disable=missing-function-docstring,missing-module-docstring
 
+import ctypes
+import json
 import os
+import sys
 import pytest
 
 # This environment var must be set before the usd imports.
 os.environ["TF_DEBUG"] = "OPENASSETIO_RESOLVER"
 from pxr import Plug, Usd, Ar
 
+from resolver_test_utils import resource_path, run_in_fresh_process, write_search_path_entity
+
 
 # Assume OpenAssetIO is configured as the custom primary resolver for
 # all tests. If you're wondering where this is configured, it may
@@ -106,6 +111,475 @@ def test_non_assetized_child_ref_assetized_grandchild():
     assert_parking_lot_structure(stage)
 
 
+# Given an active resolver cache scope, when the same asset paths are
+# resolved repeatedly, then the results match those resolved outside of
+# any cache scope.
+def test_resolve_within_cache_scope_matches_uncached():
+    resolver = Ar.GetResolver()
+    file_path = resource_path("resources/empty_shot.usda")
+    entity_ref = "bal:///floor"
+
+    expected_file_path = resolver.Resolve(file_path)
+    expected_entity_ref = resolver.Resolve(entity_ref)
+
+    with Ar.ResolverScopedCache():
+        for _ in range(3):
+            assert resolver.Resolve(file_path) == expected_file_path
+            assert resolver.Resolve(entity_ref) == expected_entity_ref
+
+    assert expected_file_path.GetPathString() == file_path
+
+
+# Given a text layer containing entity references, when the layer is
+# opened within a resolver cache scope, then its entity references are
+# resolved up front as a single batch.
+def test_entity_references_prefetched_when_layer_opened(capfd):
+    with Ar.ResolverScopedCache():
+        open_stage("resources/integration_test_data/recursive_assetized_resolve/parking_lot.usd")
+    captured = capfd.readouterr()
+
+    prefetches = [
+        output
+        for output in captured.out.split(os.environ["TF_DEBUG"])
+        if "prefetchEntityReferences" in output
+    ]
+    assert len(prefetches) == 1
+    assert "count: 1" in prefetches[0]
+
+
+# Given an entity reference, when an identifier is created for it
+# relative to an anchoring layer, then the entity reference is returned
+# untouched rather than being anchored as a relative file path.
+def test_entity_reference_identifier_is_not_anchored():
+    resolver = Ar.GetResolver()
+    anchor = Ar.ResolvedPath(resource_path("resources/empty_shot.usda"))
+
+    assert resolver.CreateIdentifier("bal:///floor", anchor) == "bal:///floor"
+    assert resolver.CreateIdentifierForNewAsset("bal:///floor", anchor) == "bal:///floor"
+
+
+# Given a plain relative file path, when an identifier is created for
+# it, then it is anchored exactly as the default resolver would.
+def test_file_path_identifier_is_anchored():
+    resolver = Ar.GetResolver()
+    anchor = Ar.ResolvedPath(resource_path("resources/empty_shot.usda"))
+
+    assert resolver.CreateIdentifier("./floor1.usd", anchor) == resource_path(
+        "resources/floor1.usd"
+    )
+
+
+# Given a stage has been opened, when the resolver call stats are read
+# through the plugin, then each called method has counts and latency
+# percentiles.
+def test_call_stats_readable_from_python():
+    plugin = Plug.Registry().GetPluginWithName("usdOpenAssetIOResolver")
+    lib = ctypes.CDLL(plugin.path)
+    lib.UsdOpenAssetIOResolverCallStatsJson.restype = ctypes.c_char_p
+    lib.UsdOpenAssetIOResolverResetCallStats()
+
+    open_stage(
+        "resources/integration_test_data/resolver_has_no_effect_with_no_search_path/parking_lot.usd"
+    )
+
+    stats = json.loads(lib.UsdOpenAssetIOResolverCallStatsJson())
+    for method in ("_CreateIdentifier", "_Resolve"):
+        assert stats[method]["count"] > 0
+        assert stats[method]["total_ns"] > 0
+        assert stats[method]["p50_ns"] <= stats[method]["p99_ns"] <= stats[method]["max_ns"]
+        assert sum(count for _, count in stats[method]["buckets"]) == stats[method]["count"]
+
+
+# Given an assetized stage has been opened, when the cache stats are
+# read through the plugin, then each budgeted cache reports its
+# counters.
+def test_cache_stats_readable_from_python():
+    plugin = Plug.Registry().GetPluginWithName("usdOpenAssetIOResolver")
+    lib = ctypes.CDLL(plugin.path)
+    lib.UsdOpenAssetIOResolverCacheStatsJson.restype = ctypes.c_char_p
+
+    open_stage("resources/integration_test_data/recursive_assetized_resolve/parking_lot.usd")
+
+    stats = json.loads(lib.UsdOpenAssetIOResolverCacheStatsJson())
+    assert set(stats) == {"resolvedPaths"}
+    for cache in stats.values():
+        assert cache["budget_bytes"] > 0
+        assert cache["bytes"] <= cache["budget_bytes"]
+    assert stats["resolvedPaths"]["hits"] + stats["resolvedPaths"]["misses"] > 0
+
+
+# Given the unresolved path cache is enabled, when a missing file is
+# created after failing to resolve, then it still fails to resolve
+# until the context is refreshed.
+def test_unresolved_path_remembered_until_context_refreshed(tmp_path):
+    asset_path = tmp_path / "created_later.usda"
+    script = (
+        "import pathlib\n"
+        "from pxr import Ar\n"
+        "resolver = Ar.GetResolver()\n"
+        f"asset_path = {str(asset_path)!r}\n"
+        "print(bool(resolver.Resolve(asset_path)))\n"
+        "pathlib.Path(asset_path).write_text('#usda 1.0\\n')\n"
+        "print(bool(resolver.Resolve(asset_path)))\n"
+        "resolver.RefreshContext(resolver.GetCurrentContext())\n"
+        "print(bool(resolver.Resolve(asset_path)))\n"
+    )
+    result = run_in_fresh_process(script, OPENASSETIO_RESOLVER_UNRESOLVED_CACHE_TTL_MS="600000")
+
+    assert result.stdout.split() == ["False", "False", "True"]
+
+
+# Given an entity reference found through the search path of each of
+# two contexts, when it is resolved repeatedly in each, then each
+# context is served its own resolution from the resolved path cache.
+def test_resolved_path_cache_separates_contexts(tmp_path):
+    search_paths = [write_search_path_entity(tmp_path / name, "cat.usda") for name in "ab"]
+    script = (
+        "import ctypes, json\n"
+        "from pxr import Ar, Plug\n"
+        "plugin = Plug.Registry().GetPluginWithName('usdOpenAssetIOResolver')\n"
+        "lib = ctypes.CDLL(plugin.path)\n"
+        "lib.UsdOpenAssetIOResolverCacheStatsJson.restype = ctypes.c_char_p\n"
+        "resolver = Ar.GetResolver()\n"
+        f"for search_path in {search_paths!r}:\n"
+        "    context = Ar.ResolverContext(Ar.DefaultResolverContext([search_path]))\n"
+        "    with Ar.ResolverContextBinder(context):\n"
+        "        for _ in range(2):\n"
+        "            print(resolver.Resolve('bal:///cat.usda').GetPathString())\n"
+        "print(json.loads(lib.UsdOpenAssetIOResolverCacheStatsJson())['resolvedPaths']['hits'])\n"
+    )
+    # The per-thread cache would otherwise serve the repeats.
+    result = run_in_fresh_process(script, OPENASSETIO_RESOLVER_THREAD_RESOLVE_CACHE="0")
+
+    cat_a, cat_b = [os.path.join(path, "bal:", "cat.usda") for path in search_paths]
+    assert result.stdout.split() == [cat_a, cat_a, cat_b, cat_b, "2"]
+
+
+# Given an entity reference resolved and cached, when a file that would
+# take precedence appears earlier in the search path, then the cached
+# resolution is used until the context is refreshed.
+def test_resolved_path_cache_cleared_when_context_refreshed(tmp_path):
+    override_path = str(tmp_path / "override")
+    fallback_path = write_search_path_entity(tmp_path / "fallback", "cat.usda")
+    script = (
+        "import os\n"
+        "from pxr import Ar\n"
+        "resolver = Ar.GetResolver()\n"
+        f"override_path = {override_path!r}\n"
+        "context = Ar.ResolverContext(\n"
+        f"    Ar.DefaultResolverContext([override_path, {fallback_path!r}]))\n"
+        "def resolve():\n"
+        "    with Ar.ResolverContextBinder(context):\n"
+        "        print(resolver.Resolve('bal:///cat.usda').GetPathString())\n"
+        "resolve()\n"
+        "os.makedirs(os.path.join(override_path, 'bal:'))\n"
+        "with open(os.path.join(override_path, 'bal:', 'cat.usda'), 'w') as file:\n"
+        "    file.write('#usda 1.0\\n')\n"
+        "resolve()\n"
+        "resolver.RefreshContext(context)\n"
+        "resolve()\n"
+    )
+    result = run_in_fresh_process(script)
+
+    fallback_cat = os.path.join(fallback_path, "bal:", "cat.usda")
+    override_cat = os.path.join(override_path, "bal:", "cat.usda")
+    assert result.stdout.split() == [fallback_cat, fallback_cat, override_cat]
+
+
+# Given the resolved path cache is disabled, when an entity reference
+# is resolved again on the same thread after a file that would take
+# precedence appears, then it is queried afresh.
+def test_entity_reference_queried_afresh_without_resolved_path_cache(tmp_path):
+    override_path = str(tmp_path / "override")
+    fallback_path = write_search_path_entity(tmp_path / "fallback", "cat.usda")
+    script = (
+        "import os\n"
+        "from pxr import Ar\n"
+        "resolver = Ar.GetResolver()\n"
+        f"override_path = {override_path!r}\n"
+        "context = Ar.ResolverContext(\n"
+        f"    Ar.DefaultResolverContext([override_path, {fallback_path!r}]))\n"
+        "with Ar.ResolverContextBinder(context):\n"
+        "    print(resolver.Resolve('bal:///cat.usda').GetPathString())\n"
+        "    os.makedirs(os.path.join(override_path, 'bal:'))\n"
+        "    with open(os.path.join(override_path, 'bal:', 'cat.usda'), 'w') as file:\n"
+        "        file.write('#usda 1.0\\n')\n"
+        "    print(resolver.Resolve('bal:///cat.usda').GetPathString())\n"
+    )
+    # The per-thread cache is left at its default, i.e. enabled.
+    result = run_in_fresh_process(
+        script,
+        OPENASSETIO_RESOLVER_RESOLVED_PATH_CACHE="0",
+        OPENASSETIO_RESOLVER_THREAD_RESOLVE_CACHE=None,
+    )
+
+    assert result.stdout.split() == [
+        os.path.join(fallback_path, "bal:", "cat.usda"),
+        os.path.join(override_path, "bal:", "cat.usda"),
+    ]
+
+
+# Given cached resolutions are revalidated in the background, when an
+# entity reference's resolution changes, then the change is applied
+# and notified on the thread that asks for it.
+def test_changed_resolution_updated_and_notified(tmp_path):
+    override_path = str(tmp_path / "override")
+    fallback_path = write_search_path_entity(tmp_path / "fallback", "cat.usda")
+    script = (
+        "import ctypes, os, threading, time\n"
+        "from pxr import Ar, Plug, Tf\n"
+        "plugin = Plug.Registry().GetPluginWithName('usdOpenAssetIOResolver')\n"
+        "lib = ctypes.CDLL(plugin.path)\n"
+        "lib.UsdOpenAssetIOResolverRevalidate.restype = ctypes.c_size_t\n"
+        "notified_on = []\n"
+        "def on_changed(notice, sender):\n"
+        "    notified_on.append(threading.get_ident())\n"
+        "listener = Tf.Notice.RegisterGlobally(Ar.Notice.ResolverChanged, on_changed)\n"
+        "resolver = Ar.GetResolver()\n"
+        f"override_path = {override_path!r}\n"
+        "context = Ar.ResolverContext(\n"
+        f"    Ar.DefaultResolverContext([override_path, {fallback_path!r}]))\n"
+        "def resolve():\n"
+        "    with Ar.ResolverContextBinder(context):\n"
+        "        print(resolver.Resolve('bal:///cat.usda').GetPathString())\n"
+        "resolve()\n"
+        "os.makedirs(os.path.join(override_path, 'bal:'))\n"
+        "with open(os.path.join(override_path, 'bal:', 'cat.usda'), 'w') as file:\n"
+        "    file.write('#usda 1.0\\n')\n"
+        "resolve()\n"
+        "changed = 0\n"
+        "deadline = time.monotonic() + 10\n"
+        "while changed == 0 and time.monotonic() < deadline:\n"
+        "    time.sleep(0.01)\n"
+        "    changed = lib.UsdOpenAssetIOResolverRevalidate()\n"
+        "print(changed, notified_on == [threading.get_ident()])\n"
+        "resolve()\n"
+    )
+    result = run_in_fresh_process(script, OPENASSETIO_RESOLVER_REVALIDATE_INTERVAL_MS="20")
+
+    fallback_cat = os.path.join(fallback_path, "bal:", "cat.usda")
+    override_cat = os.path.join(override_path, "bal:", "cat.usda")
+    assert result.stdout.split() == [fallback_cat, fallback_cat, "1", "True", override_cat]
+
+
+# Given the unresolved path cache is enabled, when a missing layer is
+# created through USD after failing to resolve, then it resolves
+# without the context being refreshed.
+def test_unresolved_path_forgotten_when_written(tmp_path):
+    asset_path = tmp_path / "created_later.usda"
+    script = (
+        "from pxr import Ar, Sdf\n"
+        "resolver = Ar.GetResolver()\n"
+        f"asset_path = {str(asset_path)!r}\n"
+        "print(bool(resolver.Resolve(asset_path)))\n"
+        "layer = Sdf.Layer.CreateNew(asset_path)\n"
+        "print(layer.Save())\n"
+        "print(bool(resolver.Resolve(asset_path)))\n"
+    )
+    result = run_in_fresh_process(script, OPENASSETIO_RESOLVER_UNRESOLVED_CACHE_TTL_MS="600000")
+
+    assert result.stdout.split() == ["False", "True", "True"]
+
+
+# Given a layer opened through an entity reference, when its file is
+# rewritten in place, then reloading the layer picks up the change.
+def test_entity_reference_layer_reloaded_after_rewrite(tmp_path):
+    search_path = write_search_path_entity(tmp_path / "search", "cat.usda")
+    layer_path = os.path.join(search_path, "bal:", "cat.usda")
+    script = (
+        "import os\n"
+        "from pxr import Ar, Sdf\n"
+        f"context = Ar.ResolverContext(Ar.DefaultResolverContext([{search_path!r}]))\n"
+        "with Ar.ResolverContextBinder(context):\n"
+        "    layer = Sdf.Layer.FindOrOpen('bal:///cat.usda')\n"
+        "    print(bool(layer.GetPrimAtPath('/Rewritten')))\n"
+        f"    with open({layer_path!r}, 'w') as file:\n"
+        "        file.write('#usda 1.0\\n\\ndef \"Rewritten\"\\n{\\n}\\n')\n"
+        f"    stat = os.stat({layer_path!r})\n"
+        "    # Ensure the modification time changes, however coarse.\n"
+        f"    os.utime({layer_path!r}, (stat.st_atime, stat.st_mtime + 10))\n"
+        "    print(layer.Reload())\n"
+        "    print(bool(layer.GetPrimAtPath('/Rewritten')))\n"
+    )
+    result = run_in_fresh_process(script)
+
+    assert result.stdout.split() == ["False", "True", "True"]
+
+
+# Given file assets are memory-mapped, when a layer is opened, then it
+# is read in full.
+def test_memory_mapped_layer_opens(tmp_path):
+    layer_path = tmp_path / "mapped.usda"
+    layer_path.write_text('#usda 1.0\n\ndef "Mapped"\n{\n}\n')
+    script = (
+        "from pxr import Ar, Usd\n"
+        f"layer_path = {str(layer_path)!r}\n"
+        "stage = Usd.Stage.Open(layer_path)\n"
+        "print(stage.GetPrimAtPath('/Mapped').IsValid())\n"
+        "resolver = Ar.GetResolver()\n"
+        "print(resolver.OpenAsset(resolver.Resolve(layer_path)).GetSize())\n"
+    )
+    result = run_in_fresh_process(
+        script,
+        OPENASSETIO_RESOLVER_MMAP_ASSETS="1",
+        OPENASSETIO_RESOLVER_MMAP_POPULATE="1",
+        OPENASSETIO_RESOLVER_MMAP_ADVICE="sequential",
+    )
+
+    assert result.stdout.split() == ["True", str(layer_path.stat().st_size)]
+
+
+# Given the asset buffer cache is enabled, when a file is opened again,
+# then it is served from the cache, until the file is rewritten.
+def test_reopened_asset_served_from_buffer_cache(tmp_path):
+    layer_path = tmp_path / "reopened.usda"
+    original = "#usda 1.0\n"
+    rewritten = '#usda 1.0\n\ndef "Rewritten"\n{\n}\n'
+    layer_path.write_text(original)
+    script = (
+        "import ctypes, json, pathlib\n"
+        "from pxr import Ar, Plug\n"
+        "plugin = Plug.Registry().GetPluginWithName('usdOpenAssetIOResolver')\n"
+        "lib = ctypes.CDLL(plugin.path)\n"
+        "lib.UsdOpenAssetIOResolverCacheStatsJson.restype = ctypes.c_char_p\n"
+        "resolver = Ar.GetResolver()\n"
+        f"layer_path = {str(layer_path)!r}\n"
+        "def open_size():\n"
+        "    return resolver.OpenAsset(resolver.Resolve(layer_path)).GetSize()\n"
+        "def hits():\n"
+        "    stats = json.loads(lib.UsdOpenAssetIOResolverCacheStatsJson())\n"
+        "    return stats['assetBuffers']['hits']\n"
+        "print(open_size(), open_size(), hits())\n"
+        f"pathlib.Path(layer_path).write_text({rewritten!r})\n"
+        "print(open_size(), hits())\n"
+    )
+    result = run_in_fresh_process(script, OPENASSETIO_RESOLVER_ASSET_CACHE_MB="16")
+
+    assert result.stdout.split() == [
+        str(len(original)),
+        str(len(original)),
+        "1",
+        str(len(rewritten)),
+        "1",
+    ]
+
+
+# Given a shared cache segment, when a layer is opened by one process,
+# then another process opening it is served from the segment.
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="Uses /dev/shm")
+def test_asset_shared_between_processes(tmp_path):
+    layer_path = tmp_path / "shared.usda"
+    layer_path.write_text("#usda 1.0\n")
+    segment = f"usdOpenAssetIOResolverTest{os.getpid()}"
+    script = (
+        "import ctypes, json\n"
+        "from pxr import Ar, Plug\n"
+        "plugin = Plug.Registry().GetPluginWithName('usdOpenAssetIOResolver')\n"
+        "lib = ctypes.CDLL(plugin.path)\n"
+        "lib.UsdOpenAssetIOResolverCacheStatsJson.restype = ctypes.c_char_p\n"
+        "resolver = Ar.GetResolver()\n"
+        f"layer_path = {str(layer_path)!r}\n"
+        "print(resolver.OpenAsset(resolver.Resolve(layer_path)).GetSize())\n"
+        "print(json.loads(lib.UsdOpenAssetIOResolverCacheStatsJson())['shared']['hits'])\n"
+    )
+    settings = {
+        "OPENASSETIO_RESOLVER_SHARED_CACHE": segment,
+        "OPENASSETIO_RESOLVER_SHARED_CACHE_MB": "4",
+        "OPENASSETIO_RESOLVER_SHARED_CACHE_ASSETS": "1",
+    }
+
+    try:
+        first, second = [
+            run_in_fresh_process(script, **settings).stdout.split() for _ in range(2)
+        ]
+    finally:
+        if os.path.exists(f"/dev/shm/{segment}"):
+            os.remove(f"/dev/shm/{segment}")
+
+    assert first == ["10", "0"]
+    assert second == ["10", "1"]
+
+
+# Given a shared cache segment, when a file that would take precedence
+# appears earlier in the search path and the context is refreshed,
+# then the resolution published to the segment before is not used.
+@pytest.mark.skipif(not sys.platform.startswith("linux"), reason="Uses /dev/shm")
+def test_shared_resolution_not_used_after_context_refreshed(tmp_path):
+    override_path = str(tmp_path / "override")
+    fallback_path = write_search_path_entity(tmp_path / "fallback", "cat.usda")
+    segment = f"usdOpenAssetIOResolverTest{os.getpid()}"
+    script = (
+        "import os\n"
+        "from pxr import Ar\n"
+        "resolver = Ar.GetResolver()\n"
+        f"override_path = {override_path!r}\n"
+        "context = Ar.ResolverContext(\n"
+        f"    Ar.DefaultResolverContext([override_path, {fallback_path!r}]))\n"
+        "def resolve():\n"
+        "    with Ar.ResolverContextBinder(context):\n"
+        "        print(resolver.Resolve('bal:///cat.usda').GetPathString())\n"
+        "resolve()\n"
+        "os.makedirs(os.path.join(override_path, 'bal:'))\n"
+        "with open(os.path.join(override_path, 'bal:', 'cat.usda'), 'w') as file:\n"
+        "    file.write('#usda 1.0\\n')\n"
+        "resolver.RefreshContext(context)\n"
+        "resolve()\n"
+    )
+    try:
+        result = run_in_fresh_process(
+            script,
+            OPENASSETIO_RESOLVER_SHARED_CACHE=segment,
+            OPENASSETIO_RESOLVER_SHARED_CACHE_MB="4",
+        )
+    finally:
+        if os.path.exists(f"/dev/shm/{segment}"):
+            os.remove(f"/dev/shm/{segment}")
+
+    fallback_cat = os.path.join(fallback_path, "bal:", "cat.usda")
+    override_cat = os.path.join(override_path, "bal:", "cat.usda")
+    assert result.stdout.split() == [fallback_cat, override_cat]
+
+
+# Given a slow mount point is localized, when a layer on it is
+# resolved, then it is copied to the local directory in the background,
+# and once copied is opened from there.
+def test_layer_on_slow_mount_opened_from_local_copy(tmp_path):
+    mount_dir = tmp_path / "nfs"
+    local_dir = tmp_path / "local"
+    mount_dir.mkdir()
+    layer_path = mount_dir / "localized.usda"
+    contents = '#usda 1.0\n\ndef "Localized"\n{\n}\n'
+    layer_path.write_text(contents)
+    script = (
+        "import ctypes, json, time\n"
+        "from pxr import Ar, Plug\n"
+        "plugin = Plug.Registry().GetPluginWithName('usdOpenAssetIOResolver')\n"
+        "lib = ctypes.CDLL(plugin.path)\n"
+        "lib.UsdOpenAssetIOResolverCacheStatsJson.restype = ctypes.c_char_p\n"
+        "resolver = Ar.GetResolver()\n"
+        f"resolved_path = resolver.Resolve({str(layer_path)!r})\n"
+        "def hits():\n"
+        "    stats = json.loads(lib.UsdOpenAssetIOResolverCacheStatsJson())\n"
+        "    return stats['localized']['hits']\n"
+        "deadline = time.monotonic() + 10\n"
+        "while hits() == 0 and time.monotonic() < deadline:\n"
+        "    size = resolver.OpenAsset(resolved_path).GetSize()\n"
+        "    time.sleep(0.01)\n"
+        "print(size, hits() > 0)\n"
+    )
+    result = run_in_fresh_process(
+        script,
+        OPENASSETIO_RESOLVER_LOCALIZE_MOUNTS=str(mount_dir),
+        OPENASSETIO_RESOLVER_LOCALIZE_DIR=str(local_dir),
+    )
+
+    assert result.stdout.split() == [str(len(contents)), "True"]
+    copies = list(local_dir.iterdir())
+    assert len(copies) == 1
+    assert copies[0].suffix == ".usda"
+    assert copies[0].read_text() == contents
+
+
 ##### Utility Functions #####
 
 # Verify OpenAssetIO configured as the AR resolver.
@@ -0,0 +1,82 @@
+# SPDX-License-Identifier: Apache-2.0
+# Copyright 2023 The Foundry Visionmongers Ltd
+
+# pylint: disable=missing-function-docstring,missing-module-docstring
+
+import os
+
+from resolver_test_utils import (
+    open_recursive_assetized_scene,
+    recursive_assetized_resolutions,
+    run_in_fresh_process,
+    write_manifest as write_pins,
+    write_search_path_entity,
+)
+
+
+# Given a version pins file pinning the entity references in an
+# assetized scene, when the scene is opened with the pins loaded, then
+# the scene is resolved using the pinned versions.
+def test_assetized_scene_resolved_from_loaded_pins(tmp_path):
+    pins = tmp_path / "job.pins"
+    write_pins(pins, recursive_assetized_resolutions())
+
+    assert open_recursive_assetized_scene(OPENASSETIO_RESOLVER_VERSION_PINS=str(pins))
+
+
+# Given version pins export is configured, when an assetized scene is
+# opened, then the exported pins alone are enough to open the scene
+# again, e.g. in a later task of the same job.
+def test_exported_pins_resolve_scene(tmp_path):
+    source_pins = tmp_path / "source.pins"
+    exported_pins = tmp_path / "exported.pins"
+    write_pins(source_pins, recursive_assetized_resolutions())
+
+    assert open_recursive_assetized_scene(
+        OPENASSETIO_RESOLVER_VERSION_PINS=str(source_pins),
+        OPENASSETIO_RESOLVER_VERSION_PINS_EXPORT=str(exported_pins),
+    )
+    assert open_recursive_assetized_scene(OPENASSETIO_RESOLVER_VERSION_PINS=str(exported_pins))
+
+
+# Given versions are pinned, when a file that would take precedence
+# appears earlier in the search path, then the pinned resolution is
+# used until the context is refreshed, whilst loaded pins are kept.
+def test_pins_made_in_context_forgotten_when_refreshed(tmp_path):
+    pins = tmp_path / "job.pins"
+    loaded_dog = str(tmp_path / "loaded" / "dog.usda")
+    write_pins(pins, {"bal:///dog.usda": loaded_dog})
+    override_path = str(tmp_path / "override")
+    fallback_path = write_search_path_entity(tmp_path / "fallback", "cat.usda")
+    write_search_path_entity(tmp_path / "fallback", "dog.usda", exist_ok=True)
+    script = (
+        "import os\n"
+        "from pxr import Ar\n"
+        "resolver = Ar.GetResolver()\n"
+        f"override_path = {override_path!r}\n"
+        "context = Ar.ResolverContext(\n"
+        f"    Ar.DefaultResolverContext([override_path, {fallback_path!r}]))\n"
+        "def resolve():\n"
+        "    with Ar.ResolverContextBinder(context):\n"
+        "        for name in ('cat', 'dog'):\n"
+        "            print(resolver.Resolve(f'bal:///{name}.usda').GetPathString())\n"
+        "resolve()\n"
+        "os.makedirs(os.path.join(override_path, 'bal:'))\n"
+        "with open(os.path.join(override_path, 'bal:', 'cat.usda'), 'w') as file:\n"
+        "    file.write('#usda 1.0\\n')\n"
+        "resolve()\n"
+        "resolver.RefreshContext(context)\n"
+        "resolve()\n"
+    )
+    result = run_in_fresh_process(script, OPENASSETIO_RESOLVER_VERSION_PINS=str(pins))
+
+    fallback_cat = os.path.join(fallback_path, "bal:", "cat.usda")
+    override_cat = os.path.join(override_path, "bal:", "cat.usda")
+    assert result.stdout.split() == [
+        fallback_cat,
+        loaded_dog,
+        fallback_cat,
+        loaded_dog,
+        override_cat,
+        loaded_dog,
+    ]
@@ -0,0 +1,233 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+// Replays a resolver call trace, recorded by setting
+// OPENASSETIO_RESOLVER_TRACE_FILE, against Ar's resolver in a fresh
+// process as fast as possible, and reports timings per resolver
+// method. Recorded context binds are replayed on the same threads, so
+// that search path lookups resolve as they did when recorded. The
+// plugin must be found via PXR_PLUGINPATH_NAME.
+
+#include <array>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pxr/base/tf/getenv.h"
+#include "pxr/base/vt/value.h"
+#include "pxr/usd/ar/defaultResolverContext.h"
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/ar/resolverContext.h"
+#include "pxr/usd/ar/resolverContextBinder.h"
+
+#include "callTrace.h"
+#include "resolverMethod.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+struct MethodStats {
+  std::uint64_t count{};
+  std::uint64_t totalNs{};
+  std::uint64_t mismatches{};
+};
+using Stats = std::array<MethodStats, kResolverMethodCount>;
+
+void printUsage() {
+  std::fprintf(stderr,
+               "Usage: usdOpenAssetIOResolverReplay [--threads] [--iterations N] "
+               "<trace-file>\n\n"
+               "  --threads        Replay each recorded thread's calls on its own thread.\n"
+               "  --iterations N   Replay the trace N times (default 1).\n");
+}
+
+// Replay a sequence of calls in order, accumulating stats.
+void replay(ArResolver &resolver, const std::vector<const CallTraceRecord *> &records,
+            Stats &stats) {
+  std::vector<VtValue> cacheScopes;
+  // Bound on Ar's resolver, innermost last.
+  std::vector<std::unique_ptr<ArResolverContextBinder>> binders;
+
+  for (const CallTraceRecord *record : records) {
+    bool matches = true;
+    const auto start = Clock::now();
+    switch (record->method) {
+      case ResolverMethod::kCreateIdentifier:
+        matches = resolver.CreateIdentifier(record->arg0, ArResolvedPath{record->arg1}) ==
+                  record->result;
+        break;
+      case ResolverMethod::kResolve:
+        matches = resolver.Resolve(record->arg0).GetPathString() == record->result;
+        break;
+      case ResolverMethod::kCreateIdentifierForNewAsset:
+        matches = resolver.CreateIdentifierForNewAsset(record->arg0,
+                                                       ArResolvedPath{record->arg1}) ==
+                  record->result;
+        break;
+      case ResolverMethod::kResolveForNewAsset:
+        matches = resolver.ResolveForNewAsset(record->arg0).GetPathString() == record->result;
+        break;
+      case ResolverMethod::kCanWriteAssetToPath:
+        matches = resolver.CanWriteAssetToPath(ArResolvedPath{record->arg0}) ==
+                  (record->result == "1");
+        break;
+      case ResolverMethod::kOpenAssetForWrite:
+        // Never replayed, so as not to modify files.
+        continue;
+      case ResolverMethod::kGetExtension:
+        matches = resolver.GetExtension(record->arg0) == record->result;
+        break;
+      case ResolverMethod::kGetAssetInfo:
+        matches = resolver.GetAssetInfo(record->arg0, ArResolvedPath{record->arg1}).assetName ==
+                  record->result;
+        break;
+      case ResolverMethod::kOpenAsset:
+        matches = (resolver.OpenAsset(ArResolvedPath{record->arg0}) != nullptr) ==
+                  !record->result.empty();
+        break;
+      case ResolverMethod::kGetModificationTimestamp:
+        // Timestamps are expected to differ between capture and replay.
+        static_cast<void>(
+            resolver.GetModificationTimestamp(record->arg0, ArResolvedPath{record->arg1}));
+        break;
+      case ResolverMethod::kBeginCacheScope:
+        cacheScopes.emplace_back();
+        resolver.BeginCacheScope(&cacheScopes.back());
+        break;
+      case ResolverMethod::kEndCacheScope:
+        if (!cacheScopes.empty()) {
+          resolver.EndCacheScope(&cacheScopes.back());
+          cacheScopes.pop_back();
+        }
+        break;
+      case ResolverMethod::kBindContext:
+        binders.push_back(std::make_unique<ArResolverContextBinder>(
+            record->arg0.empty()
+                ? ArResolverContext{}
+                : ArResolverContext{ArDefaultResolverContext{decodeSearchPath(record->arg0)}}));
+        break;
+      case ResolverMethod::kUnbindContext:
+        if (!binders.empty()) {
+          binders.pop_back();
+        }
+        break;
+    }
+    const auto end = Clock::now();
+
+    MethodStats &methodStats = stats[static_cast<std::size_t>(record->method)];
+    ++methodStats.count;
+    methodStats.totalNs += static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+    methodStats.mismatches += matches ? 0 : 1;
+  }
+
+  // Close any scopes left open by a truncated trace.
+  while (!cacheScopes.empty()) {
+    resolver.EndCacheScope(&cacheScopes.back());
+    cacheScopes.pop_back();
+  }
+  while (!binders.empty()) {
+    binders.pop_back();
+  }
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  bool perThread = false;
+  long iterations = 1;
+  std::string traceFile;
+
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  for (std::size_t idx = 0; idx < args.size(); ++idx) {
+    if (args[idx] == "--threads") {
+      perThread = true;
+    } else if (args[idx] == "--iterations" && idx + 1 < args.size()) {
+      iterations = std::strtol(args[++idx].c_str(), nullptr, 10);
+    } else if (traceFile.empty() && args[idx].rfind("--", 0) != 0) {
+      traceFile = args[idx];
+    } else {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (traceFile.empty() || iterations < 1) {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+  if (TfGetenv("OPENASSETIO_RESOLVER_TRACE_FILE") == traceFile) {
+    std::fprintf(stderr, "Refusing to record the replay over the trace being replayed\n");
+    return EXIT_FAILURE;
+  }
+
+  const auto reader = CallTraceReader::open(traceFile);
+  if (!reader) {
+    return EXIT_FAILURE;
+  }
+  std::vector<CallTraceRecord> records;
+  for (CallTraceRecord record; reader->next(record);) {
+    records.push_back(std::move(record));
+  }
+
+  // Sequences of calls to replay, each on its own thread if requested.
+  std::map<std::uint32_t, std::vector<const CallTraceRecord *>> sequences;
+  for (const CallTraceRecord &record : records) {
+    sequences[perThread ? record.threadIndex : 0].push_back(&record);
+  }
+
+  ArResolver &resolver = ArGetResolver();
+  std::vector<Stats> threadStats(sequences.size());
+
+  const auto start = Clock::now();
+  for (long iteration = 0; iteration < iterations; ++iteration) {
+    std::vector<std::thread> threads;
+    std::size_t sequenceIdx = 0;
+    for (const auto &[threadIndex, sequence] : sequences) {
+      Stats &stats = threadStats[sequenceIdx++];
+      if (perThread) {
+        threads.emplace_back(
+            [&resolver, &sequence = sequence, &stats] { replay(resolver, sequence, stats); });
+      } else {
+        replay(resolver, sequence, stats);
+      }
+    }
+    for (std::thread &thread : threads) {
+      thread.join();
+    }
+  }
+  const double wallMs =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  Stats totals{};
+  for (const Stats &stats : threadStats) {
+    for (std::size_t method = 0; method < kResolverMethodCount; ++method) {
+      totals[method].count += stats[method].count;
+      totals[method].totalNs += stats[method].totalNs;
+      totals[method].mismatches += stats[method].mismatches;
+    }
+  }
+
+  std::printf("Replayed %zu calls x %ld iterations on %zu thread(s) in %.3f ms\n\n",
+              records.size(), iterations, perThread ? sequences.size() : 1, wallMs);
+  std::printf("%-28s %12s %14s %12s %10s\n", "method", "calls", "total (us)", "mean (ns)",
+              "mismatch");
+  for (std::size_t method = 0; method < kResolverMethodCount; ++method) {
+    const MethodStats &stats = totals[method];
+    if (stats.count == 0) {
+      continue;
+    }
+    std::printf("%-28s %12" PRIu64 " %14.1f %12" PRIu64 " %10" PRIu64 "\n",
+                resolverMethodName(static_cast<ResolverMethod>(method)), stats.count,
+                static_cast<double>(stats.totalNs) / 1000.0, stats.totalNs / stats.count,
+                stats.mismatches);
+  }
+  return EXIT_SUCCESS;
+}
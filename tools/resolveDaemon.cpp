@@ -0,0 +1,135 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+// Serves entity reference resolution to the USD processes on a host
+// over a Unix domain socket, so that they share a single, warm
+// manager and its caches rather than each starting their own. Enable
+// the client in each process with OPENASSETIO_RESOLVER_DAEMON_SOCKET.
+//
+// Each client connection is served by its own thread. Requests carry
+// the search path of the client's resolver context, which is bound
+// whilst the batch of entity references is resolved.
+//
+// Resolution goes through Ar's resolver, as in any other process, so
+// the plugin must be found via PXR_PLUGINPATH_NAME.
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "pxr/usd/ar/defaultResolverContext.h"
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/ar/resolverContext.h"
+#include "pxr/usd/ar/resolverContextBinder.h"
+
+#include "resolveDaemonConnection.h"
+#include "resolver.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+// For removing the socket from the signal handler.
+std::array<char, sizeof(sockaddr_un::sun_path)> socketPathToUnlink{};
+
+void printUsage() {
+  std::fprintf(stderr, "Usage: usdOpenAssetIOResolverDaemon <socket-path>\n");
+}
+
+extern "C" void handleTerminate(int /*signal*/) {
+  ::unlink(socketPathToUnlink.data());
+  std::_Exit(EXIT_SUCCESS);
+}
+
+void serve(std::unique_ptr<ResolveDaemonConnection> connection) {
+  ArResolver &resolver = ArGetResolver();
+  std::vector<std::string> searchPath;
+  std::vector<std::string> assetPaths;
+  std::vector<std::string> resolvedPaths;
+  while (connection->receiveRequest(searchPath, assetPaths)) {
+    {
+      // Bound on Ar's resolver, as that is where the plugin looks up
+      // the context on the calling thread.
+      std::optional<ArResolverContextBinder> binder;
+      if (!searchPath.empty()) {
+        binder.emplace(ArResolverContext{ArDefaultResolverContext{searchPath}});
+      }
+      resolvedPaths.clear();
+      for (const std::string &assetPath : assetPaths) {
+        resolvedPaths.push_back(resolver.Resolve(assetPath).GetPathString());
+      }
+    }
+    if (!connection->sendResponse(resolvedPaths)) {
+      break;
+    }
+  }
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  if (argc != 2) {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+  const std::string socketPath = argv[1];
+  sockaddr_un address{};
+  if (socketPath.size() >= sizeof(address.sun_path)) {
+    std::fprintf(stderr, "Socket path '%s' is too long\n", socketPath.c_str());
+    return EXIT_FAILURE;
+  }
+  address.sun_family = AF_UNIX;
+  std::memcpy(address.sun_path, socketPath.c_str(), socketPath.size() + 1);
+  std::memcpy(socketPathToUnlink.data(), socketPath.c_str(), socketPath.size() + 1);
+
+  // The daemon resolves for itself, rather than forwarding to itself.
+  ::unsetenv("OPENASSETIO_RESOLVER_DAEMON_SOCKET");
+  if (dynamic_cast<UsdOpenAssetIOResolver *>(&ArGetUnderlyingResolver()) == nullptr) {
+    std::fprintf(stderr,
+                 "The usdOpenAssetIOResolver plugin is not Ar's resolver; check "
+                 "PXR_PLUGINPATH_NAME\n");
+    return EXIT_FAILURE;
+  }
+
+  const int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  // A socket left by a daemon that did not exit cleanly would prevent
+  // binding.
+  ::unlink(socketPath.c_str());
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  if (listener < 0 || ::bind(listener, reinterpret_cast<const sockaddr *>(&address),
+                             sizeof(address)) != 0 ||
+      ::listen(listener, SOMAXCONN) != 0) {
+    std::fprintf(stderr, "Failed to listen on '%s': %s\n", socketPath.c_str(),
+                 std::strerror(errno));
+    return EXIT_FAILURE;
+  }
+  std::signal(SIGINT, handleTerminate);
+  std::signal(SIGTERM, handleTerminate);
+  std::signal(SIGPIPE, SIG_IGN);  // NOLINT(*-cstyle-cast)
+
+  std::printf("Listening on %s\n", socketPath.c_str());
+  std::fflush(stdout);
+
+  while (true) {
+    const int fd = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+    if (fd < 0) {
+      if (errno == EINTR || errno == ECONNABORTED) {
+        continue;
+      }
+      std::fprintf(stderr, "Failed to accept connection: %s\n", std::strerror(errno));
+      return EXIT_FAILURE;
+    }
+    std::thread{serve, std::make_unique<ResolveDaemonConnection>(fd)}.detach();
+  }
+}
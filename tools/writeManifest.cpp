@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: Apache-2.0
+// Copyright 2023 The Foundry Visionmongers Ltd
+
+// Walks the layers of a stage, from its root layer, resolving every
+// entity reference found in sublayer, reference and payload arcs in
+// parallel, and writes the results as a resolution manifest for use
+// with OPENASSETIO_RESOLVER_MANIFEST.
+//
+// Each layer is parsed in full to extract its external references,
+// but no stage is composed, so this is much cheaper than opening it.
+// Asset paths are resolved through Ar's resolver, in the default
+// context for the root layer, bound in each task since bindings are
+// per thread.
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "pxr/base/work/dispatcher.h"
+#include "pxr/base/work/threadLimits.h"
+#include "pxr/usd/ar/resolvedPath.h"
+#include "pxr/usd/ar/resolver.h"
+#include "pxr/usd/ar/resolverContext.h"
+#include "pxr/usd/ar/resolverContextBinder.h"
+#include "pxr/usd/usdUtils/dependencies.h"
+
+#include "entityReferenceMatcher.h"
+#include "resolutionManifest.h"
+#include "resolver.h"
+
+// NOLINTNEXTLINE
+PXR_NAMESPACE_USING_DIRECTIVE
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+void printUsage() {
+  std::fprintf(stderr,
+               "Usage: usdOpenAssetIOResolverManifest [--threads N] <root-layer> "
+               "<manifest-file>\n\n"
+               "  --threads N   Limit the number of threads used (default all cores).\n");
+}
+
+class ManifestWalker {
+ public:
+  ManifestWalker(const EntityReferenceMatcher &entityReferenceMatcher,
+                 const std::string &rootLayer)
+      : resolver_{ArGetResolver()},
+        entityReferenceMatcher_{entityReferenceMatcher},
+        context_{resolver_.CreateDefaultContextForAsset(rootLayer)} {}
+
+  void walk(const std::string &rootLayer) {
+    const ArResolverContextBinder binder{context_};
+    const std::string identifier = resolver_.CreateIdentifier(rootLayer);
+    visit(identifier, resolver_.Resolve(identifier));
+    dispatcher_.Wait();
+  }
+
+  // The (entity reference, resolved path) pairs found, each entity
+  // reference once, however many layers it is found in.
+  [[nodiscard]] std::vector<std::pair<std::string, std::string>> resolutions() const {
+    return {resolutions_.begin(), resolutions_.end()};
+  }
+
+  [[nodiscard]] std::size_t layerCount() const { return visitedLayers_.size(); }
+  [[nodiscard]] std::size_t unresolvedCount() const { return unresolved_.size(); }
+
+ private:
+  // Extract the external references of a layer, resolve them, and
+  // visit any layers not already seen, each as its own task.
+  void visit(const std::string &identifier, const ArResolvedPath &resolvedPath) {
+    if (resolvedPath.IsEmpty()) {
+      const std::lock_guard lock{mutex_};
+      unresolved_.insert(identifier);
+      return;
+    }
+    {
+      const std::lock_guard lock{mutex_};
+      if (!visitedLayers_.insert(resolvedPath.GetPathString()).second) {
+        return;
+      }
+    }
+    const ArResolverContextBinder binder{context_};
+
+    std::vector<std::string> subLayers;
+    std::vector<std::string> references;
+    std::vector<std::string> payloads;
+    UsdUtilsExtractExternalReferences(resolvedPath.GetPathString(), &subLayers, &references,
+                                      &payloads);
+
+    for (const std::vector<std::string> *assetPaths : {&subLayers, &references, &payloads}) {
+      for (const std::string &assetPath : *assetPaths) {
+        const std::string dependency = resolver_.CreateIdentifier(assetPath, resolvedPath);
+        const ArResolvedPath dependencyPath = resolver_.Resolve(dependency);
+        if (entityReferenceMatcher_.isEntityReference(dependency) && !dependencyPath.IsEmpty()) {
+          const std::lock_guard lock{mutex_};
+          resolutions_.emplace(dependency, dependencyPath.GetPathString());
+        }
+        dispatcher_.Run([this, dependency, dependencyPath] { visit(dependency, dependencyPath); });
+      }
+    }
+  }
+
+  ArResolver &resolver_;
+  const EntityReferenceMatcher &entityReferenceMatcher_;
+  const ArResolverContext context_;
+  WorkDispatcher dispatcher_;
+
+  std::mutex mutex_;
+  std::unordered_set<std::string> visitedLayers_;
+  std::unordered_set<std::string> unresolved_;
+  std::unordered_map<std::string, std::string> resolutions_;
+};
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  std::vector<std::string> paths;
+  const std::vector<std::string> args(argv + 1, argv + argc);
+  for (std::size_t idx = 0; idx < args.size(); ++idx) {
+    if (args[idx] == "--threads" && idx + 1 < args.size()) {
+      WorkSetConcurrencyLimitArgument(std::atoi(args[++idx].c_str()));
+    } else if (args[idx].rfind("--", 0) != 0) {
+      paths.push_back(args[idx]);
+    } else {
+      printUsage();
+      return EXIT_FAILURE;
+    }
+  }
+  if (paths.size() != 2) {
+    printUsage();
+    return EXIT_FAILURE;
+  }
+  const std::string &rootLayer = paths[0];
+  const std::string &manifestFile = paths[1];
+
+  const auto *const plugin = dynamic_cast<UsdOpenAssetIOResolver *>(&ArGetUnderlyingResolver());
+  if (plugin == nullptr) {
+    std::fprintf(stderr,
+                 "The usdOpenAssetIOResolver plugin is not Ar's resolver; check "
+                 "PXR_PLUGINPATH_NAME\n");
+    return EXIT_FAILURE;
+  }
+
+  const auto start = Clock::now();
+  ManifestWalker walker{plugin->entityReferenceMatcher(), rootLayer};
+  walker.walk(rootLayer);
+  if (walker.layerCount() == 0) {
+    std::fprintf(stderr, "Failed to resolve root layer '%s'\n", rootLayer.c_str());
+    return EXIT_FAILURE;
+  }
+  std::vector<std::pair<std::string, std::string>> resolutions = walker.resolutions();
+  const std::size_t resolutionCount = resolutions.size();
+  if (!ResolutionManifest::write(manifestFile, std::move(resolutions))) {
+    return EXIT_FAILURE;
+  }
+  const double wallMs =
+      std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+  std::printf("Wrote %zu entity reference resolutions from %zu layers in %.3f ms\n",
+              resolutionCount, walker.layerCount(), wallMs);
+  if (walker.unresolvedCount() != 0) {
+    std::printf("%zu asset paths could not be resolved\n", walker.unresolvedCount());
+  }
+  return EXIT_SUCCESS;
+}